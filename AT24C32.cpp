@@ -0,0 +1,77 @@
+#include "AT24C32.h"
+
+AT24C32::AT24C32(uint8_t i2cAddress)
+  : address(i2cAddress), present(false) {
+}
+
+bool AT24C32::begin() {
+  Wire.beginTransmission(address);
+  present = (Wire.endTransmission() == 0);
+  
+  #if DEBUG_ENABLED
+    Serial.println(present ? F("EEPROM OK") : F("WARN: No EEPROM"));
+  #endif
+  return present;
+}
+
+bool AT24C32::waitReady() {
+  // The chip ignores its address while a page write is programming
+  const unsigned long start = millis();
+  do {
+    Wire.beginTransmission(address);
+    if (Wire.endTransmission() == 0) return true;
+  } while (millis() - start < EEPROM_WRITE_TIMEOUT_MS);
+  
+  return false;
+}
+
+bool AT24C32::setAddress(uint16_t memAddress) {
+  if (!waitReady()) return false;
+  
+  Wire.beginTransmission(address);
+  Wire.write((uint8_t)(memAddress >> 8));
+  Wire.write((uint8_t)(memAddress & 0xFF));
+  return true;
+}
+
+bool AT24C32::read(uint16_t memAddress, void* data, uint16_t length) {
+  if (!present || memAddress + length > EEPROM_SIZE) return false;
+  
+  uint8_t* out = static_cast<uint8_t*>(data);
+  while (length > 0) {
+    const uint8_t chunk = min(length, (uint16_t)BUFFER_LENGTH);
+    
+    if (!setAddress(memAddress) || Wire.endTransmission(false) != 0) return false;
+    if (Wire.requestFrom(address, chunk) != chunk) return false;
+    
+    for (uint8_t i = 0; i < chunk; i++) {
+      *out++ = Wire.read();
+    }
+    memAddress += chunk;
+    length -= chunk;
+  }
+  
+  return true;
+}
+
+bool AT24C32::write(uint16_t memAddress, const void* data, uint16_t length) {
+  if (!present || memAddress + length > EEPROM_SIZE) return false;
+  
+  const uint8_t* in = static_cast<const uint8_t*>(data);
+  while (length > 0) {
+    // Stay inside the page (the address counter wraps within it) and the
+    // Wire buffer
+    const uint8_t pageRoom = EEPROM_PAGE_SIZE - (memAddress % EEPROM_PAGE_SIZE);
+    const uint8_t chunk = min(length, (uint16_t)min(pageRoom, MAX_WRITE_CHUNK));
+    
+    if (!setAddress(memAddress)) return false;
+    Wire.write(in, chunk);
+    if (Wire.endTransmission() != 0) return false;
+    
+    in += chunk;
+    memAddress += chunk;
+    length -= chunk;
+  }
+  
+  return true;
+}
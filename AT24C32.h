@@ -0,0 +1,35 @@
+#ifndef AT24C32_H
+#define AT24C32_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "Config.h"
+
+// 4 KB I2C EEPROM on the DS3231 module. Writes are split at 32-byte page
+// boundaries (and the Wire buffer); each one then programs internally for
+// up to 5 ms, which the next access waits out by ACK polling.
+class AT24C32 {
+private:
+  uint8_t address;
+  bool present;
+  
+  bool waitReady();
+  bool setAddress(uint16_t memAddress);
+
+public:
+  // Largest write that is one Wire transaction, and so one program cycle
+  // when it sits inside a page (the two address bytes share the buffer)
+  static const uint8_t MAX_WRITE_CHUNK = BUFFER_LENGTH - 2;
+  
+  AT24C32(uint8_t i2cAddress = EEPROM_I2C_ADDRESS);
+  
+  // Initialization (Wire must already be started)
+  bool begin();
+  bool isPresent() const { return present; }
+  
+  // Byte access; false on a bus error or out-of-range address
+  bool read(uint16_t memAddress, void* data, uint16_t length);
+  bool write(uint16_t memAddress, const void* data, uint16_t length);
+};
+
+#endif // AT24C32_H
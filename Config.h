@@ -9,11 +9,53 @@
 #define ENCODER_DT_PIN 4
 #define ENCODER_SW_PIN 5
 #define HEATER_CONTROL_PIN 6
+#define RTC_INT_PIN 7       // DS3231 INT/SQW (open drain, active low)
+
+// Encoder port mapping for the pin-change decoder (must match the pins above:
+// digital 3/4/5 are PD3/PD4/PD5, all on PCINT2)
+#define ENCODER_PIN_REG PIND
+#define ENCODER_CLK_BIT PD3
+#define ENCODER_DT_BIT PD4
+#define ENCODER_SW_BIT PD5
+#define ENCODER_PCMSK PCMSK2
+#define ENCODER_PCIE PCIE2
+
+// DS3231 alarm line: digital 7 is PD7, sharing the encoder's PCINT2 vector
+#define RTC_INT_PIN_REG PIND
+#define RTC_INT_BIT PD7
+#define RTC_INT_PCMSK PCMSK2
+#define RTC_INT_PCIE PCIE2
 
 // HARDWARE CONFIGURATION
 const int SERIAL_BAUD_RATE = 9600;
 const unsigned long DISPLAY_INTERVAL = 200;  // ms
-const unsigned long DEBOUNCE_TIME = 1;       // ms
+const uint8_t BUTTON_DEBOUNCE_TICKS = 5;     // Timer0 ticks (~1 ms) the switch must hold still
+const int8_t ENCODER_STEPS_PER_DETENT = 4;   // Quadrature transitions per click (2 for half-step encoders)
+const uint8_t INPUT_QUEUE_SIZE = 16;         // ISR → loop input events (power of two)
+
+// Encoder acceleration: detent interval → step multiplier (capped per sub-menu)
+const unsigned long ENCODER_ACCEL_SLOW_MS = 120;  // Detents this far apart move 1 unit
+const unsigned long ENCODER_ACCEL_FAST_MS = 25;   // Detents this close move ENCODER_ACCEL_MAX
+const uint8_t ENCODER_ACCEL_MAX = 10;
+
+// TEMPERATURE REPRESENTATION
+// Temperatures are fixed-point centi-degrees (2150 = 21.50°C) so the
+// control path never touches soft-float on the FPU-less ATmega328P.
+typedef int16_t temp_t;
+const temp_t TEMP_SCALE = 100;                       // units per °C
+#define TEMP_C(deg) ((temp_t)((deg) * TEMP_SCALE))   // compile-time literal
+
+// TEMPERATURE SENSOR
+const uint8_t TEMP_SENSOR_RESOLUTION = 12;          // bits (750 ms conversion)
+const unsigned long TEMP_SAMPLE_INTERVAL = 2000;    // ms between conversions
+const uint8_t TEMP_SENSOR_MAX_DEVICES = 2;          // ROM codes cached in SRAM
+
+// Cabin temperature filter (median + spike rejection between sensor and control)
+const uint8_t TEMP_FILTER_SIZE = 5;                  // Median window (samples)
+const uint8_t TEMP_FILTER_MIN_SAMPLES = 3;           // Control waits for this many
+const uint8_t TEMP_FILTER_MAX_REJECTS = 3;           // Consecutive spikes = real step
+const temp_t TEMP_FILTER_SPIKE_LIMIT = TEMP_C(3.0);  // Max jump from median per sample
+const temp_t TEMP_POWER_ON_VALUE = TEMP_C(85);       // DS18B20 reset register value
 
 // HEATER CONTROL
 
@@ -25,15 +67,27 @@ const uint8_t WIPER_HIGH_SAFE = 28;  // ~2.2kΩ
 const uint8_t WIPER_MAX_SAFE = 30;   // Maximum safe value
 
 // Thermostat Behavior
-const float DIFF_HIGH = 3.0;  // target - cabin ≥ 3 → HIGH
-const float DIFF_MED = 1.0;   // target - cabin ≥ 1 → MED
-const float HYS_ON = 1.5;     // turn ON if below target by ≥ 1.5
-const float HYS_OFF = 0.5;    // allow OFF only if above target by ≥ 0.5
+const temp_t DIFF_HIGH = TEMP_C(3.0);  // target - cabin ≥ 3 → HIGH
+const temp_t DIFF_MED = TEMP_C(1.0);   // target - cabin ≥ 1 → MED
+const temp_t HYS_ON = TEMP_C(1.5);     // turn ON if below target by ≥ 1.5
+const temp_t HYS_OFF = TEMP_C(0.5);    // allow OFF only if above target by ≥ 0.5
+
+// PI wiper control (CONTROL_PI): gains in 1/65536 wiper steps
+const int32_t PI_KP_Q16 = 1311;          // per centi-degree (3°C error → +6 steps)
+const int32_t PI_KI_Q16 = 22;            // per centi-degree-second (0.5°C → ~1 step/min)
+const unsigned long PI_MAX_DT_MS = 5000; // cap one integration step after stalls
+
+// Sensor resolution governor: distance from the nearest live thermostat
+// threshold picks the DS18B20 bit depth (12-bit = 750 ms, 9-bit = 94 ms)
+const temp_t RES_BAND_12BIT = TEMP_C(0.5);  // within 0.5°C → 12-bit (0.0625°C)
+const temp_t RES_BAND_11BIT = TEMP_C(1.0);  // within 1°C   → 11-bit (0.125°C)
+const temp_t RES_BAND_10BIT = TEMP_C(2.0);  // within 2°C   → 10-bit, else 9-bit
 
 // Timings
 const unsigned long MIN_ON_MS = 10UL * 60UL * 1000UL;  // ≥10 min on
 const unsigned long MIN_OFF_MS = 5UL * 60UL * 1000UL;  // ≥5 min off
 const unsigned long WIPER_STEP_DELAY_MS = 120UL;       // smooth ramp
+const uint8_t WIPER_STEP_SIZE = 1;                     // counts per ramp step
 
 // DISPLAY CONFIG
 const unsigned long POWER_SAVE_TIMEOUT = 30000;
@@ -41,9 +95,28 @@ const unsigned long BUTTON_LONG_PRESS_TIME = 1000;
 const unsigned long BUTTON_DOUBLE_CLICK_TIME = 300;
 const unsigned long DISPLAY_UPDATE_INTERVAL = 200;
 
+// SCHEDULER CONFIG
+const uint8_t MAX_SCHEDULED_TASKS = 6;           // Fixed task table size
+const unsigned long TEMP_POLL_INTERVAL = 20;      // ms between sensor state machine polls
+const unsigned long HEATER_UPDATE_INTERVAL = 1000;
+const unsigned long HEALTH_CHECK_INTERVAL = 10000;
+const unsigned long INPUT_POLL_INTERVAL = 10;     // Longest idle between input polls
+
+// Power-down idle (display off, nothing in progress): the watchdog times
+// the sleep and millis() is advanced by a conservative share of it
+const unsigned long POWER_DOWN_MIN_MS = 16;       // Shortest watchdog period; less uses IDLE
+const uint8_t WDT_CREDIT_PERCENT = 90;            // WDT oscillator is only good to ~10%
+
+// Display frame buffer: 0 = full (1 KB), 1 = one page (128 B), 2 = two pages (256 B).
+// Page modes redraw the screen once per page via firstPage()/nextPage().
+#define DISPLAY_BUFFER_MODE 1
+
 // Screen dimensions
 const int SCREEN_WIDTH = 128;
 const int SCREEN_HEIGHT = 64;
+const uint8_t DISPLAY_TILE_COLS = SCREEN_WIDTH / 8;   // u8g2 8x8 tiles
+const uint8_t DISPLAY_TILE_ROWS = SCREEN_HEIGHT / 8;
+const unsigned long DISPLAY_FULL_REFRESH_INTERVAL = 10000;  // Resend every tile
 
 // Fonts
 #define FONT_SMALL u8g2_font_6x10_tf
@@ -59,16 +132,48 @@ const int MENU_TIMEOUT = 15000;       // 15 seconds auto-exit
 const int RTC_VALID_YEAR_MIN = 2020;
 const int RTC_VALID_YEAR_MAX = 2099;
 const int RTC_TIME_JUMP_THRESHOLD = 300;  // 5 minutes in seconds
+const unsigned long RTC_RESYNC_INTERVAL = 60000;  // Software clock ← DS3231 read
+const unsigned long RTC_CONFIRM_DELAY = 2000;  // Re-read this soon after a rejected read
+const int RTC_CONFIRM_TOLERANCE = 2;           // Seconds two reads may disagree by and still agree
+
+// EEPROM (AT24C32 on the DS3231 module: 4 KB in 32-byte pages)
+const uint8_t EEPROM_I2C_ADDRESS = 0x57;          // A0-A2 pulled high on the module
+const uint16_t EEPROM_SIZE = 4096;
+const uint8_t EEPROM_PAGE_SIZE = 32;
+const unsigned long EEPROM_WRITE_TIMEOUT_MS = 10;  // Worst-case page program time
+const uint16_t EEPROM_TIMER_BASE = 0x000;         // Wake-up timer table (0x000-0x7FF)
+const uint16_t EEPROM_TIMER_SIZE = 0x800;
+const uint16_t EEPROM_SETTINGS_BASE = 0x800;      // Settings log (0x800-0xFFF)
+const uint16_t EEPROM_SETTINGS_SIZE = 0x800;
+const uint8_t SETTINGS_RECORD_SIZE = 16;          // Two records per page, never straddling
+const uint8_t SETTINGS_DAMAGE_PROBE = 3;          // Slots checked past the searched head
+const unsigned long SETTINGS_SAVE_DELAY = 5000;   // Quiet time before a change is written
 
 // WAKEUP CONFIG
-const int MAX_WAKEUP_TIMERS = 3;  // Maximum number of wake-up timers
+const int MAX_WAKEUP_TIMERS = 48;  // Stored in the AT24C32, one page each
+const uint8_t WAKEUP_CACHE_SIZE = 4;  // Upcoming occurrences held in SRAM
 const unsigned long WAKEUP_PREHEAT_MINUTES = 30;  // Start heating 30 min before target time
+const unsigned long WAKEUP_HOLD_MINUTES = 60;     // Keep heating 1 h after target time
 const int MIN_WAKEUP_TEMP = 15;   // Minimum wake-up target temperature
 const int MAX_WAKEUP_TEMP = 30;   // Maximum wake-up target temperature
+const temp_t WAKEUP_READY_MARGIN = TEMP_C(1.0);  // "Ready" when within 1°C of target
+const unsigned long WAKEUP_ACTIVE_INTERVAL = 5000;       // Re-check while a timer is heating
+const unsigned long WAKEUP_ALARM_POLL_INTERVAL = 60000;  // Read the A1 flag if INT is missed
 
 // ENUMS
 enum HeatState { HS_OFF, HS_LOW, HS_MED, HS_HIGH };
 
+// Heater power control strategy
+enum HeaterControlMode {
+  CONTROL_LADDER,  // Three fixed wiper levels (LOW/MED/HIGH)
+  CONTROL_PI       // Continuous wiper from a PI loop on the error
+};
+
+// Default strategy at boot (override with -DHEATER_CONTROL_MODE=CONTROL_PI)
+#ifndef HEATER_CONTROL_MODE
+#define HEATER_CONTROL_MODE CONTROL_LADDER
+#endif
+
 // Wake-up timer states
 enum WakeupState { 
   WAKEUP_DISABLED,    // Timer is off
@@ -104,6 +209,10 @@ enum WakeupDay {
   #define DEBUG_PRINTLN_F(x)
 #endif
 
+// PROFILER CONFIG (per-stage loop timing over serial; costs nothing when 0)
+#define PROFILER_ENABLED 0
+const unsigned long PROFILER_DUMP_INTERVAL = 30000;  // ms between periodic dumps
+
 // LIMITS
 const int MIN_TARGET_TEMP = 5;   // Minimum target temperature (°C)
 const int MAX_TARGET_TEMP = 40;  // Maximum target temperature (°C)
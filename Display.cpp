@@ -1,8 +1,9 @@
 #include "Config.h"
 #include "Display.h"
 
-Display::Display(U8G2_SH1106_128X64_NONAME_F_HW_I2C* displayPtr)
-  : u8g2(displayPtr), currentMode(DISPLAY_MAIN), displayOn(true), lastUpdate(0) {
+Display::Display(DisplayDriver* displayPtr)
+  : u8g2(displayPtr), currentMode(DISPLAY_MAIN), displayOn(true), lastUpdate(0),
+    fullRefresh(true), lastFullRefresh(0), tilesSent(0) {
 }
 
 bool Display::begin() {
@@ -12,15 +13,20 @@ bool Display::begin() {
   }
   
   u8g2->enableUTF8Print();
-  u8g2->setFont(FONT_SMALL);
   
   // Show startup message briefly
-  u8g2->clearBuffer();
-  drawCenteredText("Eberspacher", 28);
-  drawCenteredText("TempCtrl", 40);
-  drawCenteredText("v1.0", 52);
-  u8g2->sendBuffer();
+  #if DISPLAY_BUFFER_MODE == 0
+    u8g2->clearBuffer();
+    drawSplashScreen();
+    u8g2->sendBuffer();
+  #else
+    u8g2->firstPage();
+    do {
+      drawSplashScreen();
+    } while (u8g2->nextPage());
+  #endif
   delay(500);
+  invalidate();
   
   DEBUG_PRINTLN_F("Display OK");
   return true;
@@ -55,19 +61,100 @@ void Display::setPowerSave(bool enabled) {
   }
 }
 
-void Display::update(const DisplayData& data) {
+bool Display::update(const DisplayData& data) {
   // Throttle updates to reduce flicker
   const unsigned long now = millis();
   if (now - lastUpdate < DISPLAY_UPDATE_INTERVAL && currentMode != DISPLAY_MENU) {
-    return;
+    return false;
   }
   
   if (!displayOn && currentMode != DISPLAY_POWER_SAVE) {
-    return;
+    return false;
   }
   
-  u8g2->clearBuffer();
+  render(data);
+  lastUpdate = now;
+  return true;
+}
+
+bool Display::isRefreshDue() const {
+  return fullRefresh || millis() - lastFullRefresh >= DISPLAY_FULL_REFRESH_INTERVAL;
+}
+
+void Display::render(const DisplayData& data) {
+  // A periodic full frame recovers from CRC collisions and panel glitches
+  const unsigned long now = millis();
+  if (now - lastFullRefresh >= DISPLAY_FULL_REFRESH_INTERVAL) {
+    fullRefresh = true;
+  }
+  
+  // Draw one buffer's worth of tile rows at a time (the whole screen in
+  // full-buffer mode) and send only the tiles that changed
+  const uint8_t pageRows = u8g2->getBufferTileHeight();
+  tilesSent = 0;
+  
+  for (uint8_t row = 0; row < DISPLAY_TILE_ROWS; row += pageRows) {
+    u8g2->setBufferCurrTileRow(row);
+    u8g2->clearBuffer();
+    drawScreen(data);
+    flushDirtyTiles(row, pageRows);
+  }
   
+  if (fullRefresh) {
+    fullRefresh = false;
+    lastFullRefresh = now;
+  }
+}
+
+void Display::flushDirtyTiles(uint8_t firstRow, uint8_t rowCount) {
+  uint8_t* buffer = u8g2->getBufferPtr();
+  
+  for (uint8_t r = 0; r < rowCount; r++) {
+    const uint8_t row = firstRow + r;
+    uint8_t* rowBuffer = buffer + (uint16_t)r * DISPLAY_TILE_COLS * 8;
+    uint8_t* crcs = &tileCrcs[row * DISPLAY_TILE_COLS];
+    uint8_t runStart = 0;
+    uint8_t runLength = 0;
+    
+    // Coalesce adjacent dirty tiles into one transfer per run
+    for (uint8_t col = 0; col < DISPLAY_TILE_COLS; col++) {
+      const uint8_t crc = tileCrc8(rowBuffer + col * 8);
+      if (fullRefresh || crc != crcs[col]) {
+        crcs[col] = crc;
+        if (runLength == 0) runStart = col;
+        runLength++;
+      } else if (runLength > 0) {
+        sendTiles(runStart, row, runLength, rowBuffer);
+        runLength = 0;
+      }
+    }
+    
+    if (runLength > 0) {
+      sendTiles(runStart, row, runLength, rowBuffer);
+    }
+  }
+}
+
+void Display::sendTiles(uint8_t col, uint8_t row, uint8_t count, uint8_t* rowBuffer) {
+  #if DISPLAY_BUFFER_MODE == 0
+    u8g2->updateDisplayArea(col, row, count, 1);
+  #else
+    // updateDisplayArea() only works with a full buffer; this is the same
+    // tile transfer it performs, pointed at the current page
+    u8x8_DrawTile(u8g2->getU8x8(), col, row, count, rowBuffer + col * 8);
+  #endif
+  tilesSent += count;
+}
+
+uint8_t Display::tileCrc8(const uint8_t* tile) {
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    crc = _crc8_ccitt_update(crc, tile[i]);
+  }
+  return crc;
+}
+
+void Display::drawScreen(const DisplayData& data) {
   switch (currentMode) {
     case DISPLAY_MAIN:
       drawMainScreen(data);
@@ -89,16 +176,21 @@ void Display::update(const DisplayData& data) {
       drawPowerSaveScreen();
       break;
   }
-  
-  u8g2->sendBuffer();
-  lastUpdate = now;
 }
 
 void Display::forceUpdate(const DisplayData& data) {
+  invalidate();
   lastUpdate = 0;
   update(data);
 }
 
+void Display::drawSplashScreen() {
+  u8g2->setFont(FONT_SMALL);
+  drawCenteredText("Eberspacher", 28);
+  drawCenteredText("TempCtrl", 40);
+  drawCenteredText("v1.0", 52);
+}
+
 void Display::drawMainScreen(const DisplayData& data) {
   // Top row: Time and RTC status
   drawTimeInfo(data);
@@ -114,8 +206,8 @@ void Display::drawMainScreen(const DisplayData& data) {
 }
 
 void Display::drawTimeInfo(const DisplayData& data) {
-  char timeStr[16];
-  snprintf(timeStr, sizeof(timeStr), "%02d:%02d", data.hour, data.minute);
+  char timeStr[6];
+  Format::clock(timeStr, data.hour, data.minute);
   
   u8g2->setFont(FONT_SMALL);
   u8g2->drawStr(2, 12, timeStr);
@@ -139,32 +231,32 @@ void Display::drawTemperatureInfo(const DisplayData& data) {
   u8g2->setFont(FONT_SMALL);
   u8g2->drawStr(8, 30, "TEMP");
   
-  // Current temperature - large font (debug with simpler format)
+  // Current temperature in tenths - large font
   u8g2->setFont(FONT_LARGE);
   char tempStr[16];
   
-  // Debug: Check if we have valid temperature data
-  if (data.cabinTemp > -50 && data.cabinTemp < 100) {
-    // Try integer format first to isolate floating point issues
-    int tempInt = (int)data.cabinTemp;
-    snprintf(tempStr, sizeof(tempStr), "%dC", tempInt);
+  // Check if we have valid temperature data
+  if (data.cabinTemp > TEMP_C(-50) && data.cabinTemp < TEMP_C(100)) {
+    Format::character(Format::tenths(tempStr, displayedTemp(data.cabinTemp)), 'C');
   } else {
     // Show error indicator
-    snprintf(tempStr, sizeof(tempStr), "ERR");
+    strcpy(tempStr, "ERR");
   }
   
   u8g2->drawStr(35, 38, tempStr);
   
-  // Target temperature - smaller font (simplified)
+  // Target temperature - smaller font (whole degrees are all it can be set to)
   u8g2->setFont(FONT_MEDIUM);
-  int targetInt = (int)data.targetTemp;
-  snprintf(tempStr, sizeof(tempStr), ">%dC", targetInt);
+  char* p = Format::character(tempStr, '>');
+  p = Format::number(p, displayedTemp(data.targetTemp) / 10);
+  Format::character(p, 'C');
   u8g2->drawStr(90, 32, tempStr);
   
   // Temperature difference for debug
   if (data.showDebug) {
-    float diff = data.targetTemp - data.cabinTemp;
-    snprintf(tempStr, sizeof(tempStr), "D%.1fC", diff);
+    p = Format::character(tempStr, 'D');
+    p = Format::temperature(p, data.targetTemp - data.cabinTemp);
+    Format::character(p, 'C');
     u8g2->setFont(FONT_SMALL);
     u8g2->drawStr(90, 44, tempStr);
   }
@@ -221,13 +313,7 @@ void Display::drawDelayInfo(const DisplayData& data) {
   
   if (data.delayRemaining > 0) {
     char delayStr[16];
-    unsigned long seconds = data.delayRemaining / 1000;
-    
-    if (seconds > 60) {
-      snprintf(delayStr, sizeof(delayStr), "%lum%lus", seconds / 60, seconds % 60);
-    } else {
-      snprintf(delayStr, sizeof(delayStr), "%lus", seconds);
-    }
+    Format::duration(delayStr, data.delayRemaining / 1000);
     
     drawRightAlignedText(delayStr, 125, 58);
   }
@@ -244,7 +330,7 @@ void Display::drawMenuScreen(const DisplayData& data) {
     
     // Show current value being adjusted
     char valueStr[16];
-    snprintf(valueStr, sizeof(valueStr), "%d°C", data.subMenuValue);
+    Format::text(Format::number(valueStr, data.subMenuValue), "°C");
     
     u8g2->setFont(FONT_LARGE);
     drawCenteredText(valueStr, 40);
@@ -252,7 +338,7 @@ void Display::drawMenuScreen(const DisplayData& data) {
     // Show range
     u8g2->setFont(FONT_SMALL);
     char rangeStr[32];
-    snprintf(rangeStr, sizeof(rangeStr), "Range: %d-%d°C", data.subMenuMin, data.subMenuMax);
+    formatRange(rangeStr, data.subMenuMin, data.subMenuMax, "°C");
     drawCenteredText(rangeStr, 52);
     
     drawCenteredText("Rotate: adjust, Press: save", 62);
@@ -277,10 +363,11 @@ void Display::drawMenuScreen(const DisplayData& data) {
       // Highlight selected item
       if (i == data.menuIndex) {
         u8g2->drawStr(2, y, ">");
-        u8g2->drawStr(10, y, data.menuItems[i]);
-      } else {
-        u8g2->drawStr(10, y, data.menuItems[i]);
       }
+      
+      // Labels stay in flash; print() reads them without a RAM copy
+      u8g2->setCursor(10, y);
+      u8g2->print((const __FlashStringHelper*)data.menuItems[displayIndex]);
     }
     
     // Draw scroll indicators
@@ -297,7 +384,9 @@ void Display::drawMenuScreen(const DisplayData& data) {
       
       // Show scroll position indicator
       char scrollInfo[8];
-      snprintf(scrollInfo, sizeof(scrollInfo), "%d/%d", data.menuIndex + 1, data.menuCount);
+      char* p = Format::number(scrollInfo, data.menuIndex + 1);
+      p = Format::character(p, '/');
+      Format::number(p, data.menuCount);
       u8g2->setFont(FONT_SMALL);
       u8g2->drawStr(85, 16, scrollInfo);
     }
@@ -308,7 +397,7 @@ void Display::drawWakeupTimerFlow(const DisplayData& data) {
   // Step indicators at top
   u8g2->setFont(FONT_SMALL);
   char stepStr[16];
-  snprintf(stepStr, sizeof(stepStr), "Step %d/4", data.wakeupFlowStep + 1);
+  Format::text(Format::number(Format::text(stepStr, "Step "), data.wakeupFlowStep + 1), "/4");
   drawCenteredText(stepStr, 12);
   
   // Main content based on current step
@@ -320,20 +409,20 @@ void Display::drawWakeupTimerFlow(const DisplayData& data) {
   switch (data.wakeupFlowStep) {
     case 0:  // Set hour
       strcpy(titleStr, "Set Hour");
-      snprintf(valueStr, sizeof(valueStr), "%02d:xx", data.subMenuValue);
+      Format::text(Format::twoDigits(valueStr, data.subMenuValue), ":xx");
       strcpy(helpStr, "Range: 0-23");
       break;
       
     case 1:  // Set minute
       strcpy(titleStr, "Set Minute");
-      snprintf(valueStr, sizeof(valueStr), "%02d:%02d", data.wakeupHour, data.subMenuValue);
+      Format::clock(valueStr, data.wakeupHour, data.subMenuValue);
       strcpy(helpStr, "Range: 0-59");
       break;
       
     case 2:  // Set temperature
       strcpy(titleStr, "Target Temp");
-      snprintf(valueStr, sizeof(valueStr), "%d°C", data.subMenuValue);
-      snprintf(helpStr, sizeof(helpStr), "Range: %d-%d°C", data.subMenuMin, data.subMenuMax);
+      Format::text(Format::number(valueStr, data.subMenuValue), "°C");
+      formatRange(helpStr, data.subMenuMin, data.subMenuMax, "°C");
       break;
       
     case 3:  // Set days
@@ -351,8 +440,11 @@ void Display::drawWakeupTimerFlow(const DisplayData& data) {
     case 4:  // Confirm
       strcpy(titleStr, "Create Timer?");
       strcpy(valueStr, data.subMenuValue ? "YES" : "NO");
-      snprintf(helpStr, sizeof(helpStr), "%02d:%02d %d°C", 
-               data.wakeupHour, data.wakeupMinute, data.wakeupTemp);
+      {
+        char* p = Format::clock(helpStr, data.wakeupHour, data.wakeupMinute);
+        p = Format::character(p, ' ');
+        Format::text(Format::number(p, data.wakeupTemp), "°C");
+      }
       break;
       
     default:
@@ -377,9 +469,29 @@ void Display::drawDebugScreen(const DisplayData& data) {
   u8g2->setFont(FONT_SMALL);
   drawCenteredText("DEBUG INFO", 12);
   
-  u8g2->drawStr(2, 24, data.debugLine1);
-  u8g2->drawStr(2, 36, data.debugLine2);
-  u8g2->drawStr(2, 48, data.debugLine3);
+  char line[32];
+  char* p = Format::text(line, "Temp: ");
+  p = Format::temperature(p, data.cabinTemp);
+  Format::text(p, "°C");
+  u8g2->drawStr(2, 24, line);
+  
+  p = Format::text(line, "Heater: ");
+  p = Format::number(p, data.heaterState);
+  p = Format::text(p, " W:");
+  p = Format::number(p, data.wiperValue);
+  p = Format::character(p, '/');
+  Format::number(p, data.wiperTarget);
+  u8g2->drawStr(2, 36, line);
+  
+  // Errors: T0 R0 D0 H0
+  static const char errorTags[] = "TRDH";  // In DERR_* bit order
+  p = Format::text(line, "Errors:");
+  for (uint8_t i = 0; i < 4; i++) {
+    p = Format::character(p, ' ');
+    p = Format::character(p, errorTags[i]);
+    p = Format::character(p, (data.errorFlags & (1 << i)) ? '1' : '0');
+  }
+  u8g2->drawStr(2, 48, line);
   
   // Instructions
   u8g2->drawStr(2, 60, "Long press to exit");
@@ -390,8 +502,8 @@ void Display::drawTimeSetScreen(const DisplayData& data) {
   drawCenteredText("SET TIME", 16);
   
   // Show current time being set
-  char timeStr[16];
-  snprintf(timeStr, sizeof(timeStr), "%02d:%02d", data.hour, data.minute);
+  char timeStr[6];
+  Format::clock(timeStr, data.hour, data.minute);
   
   u8g2->setFont(FONT_LARGE);
   drawCenteredText(timeStr, 40);
@@ -403,7 +515,16 @@ void Display::drawTimeSetScreen(const DisplayData& data) {
 
 void Display::drawPowerSaveScreen() {
   // Blank screen for power saving
-  // u8g2 buffer is already cleared, so just send empty buffer
+  // u8g2 buffer/page is already cleared, so just send it empty
+}
+
+char* Display::formatRange(char* out, int minValue, int maxValue, const char* unit) {
+  // "Range: 5-40°C"
+  char* p = Format::text(out, "Range: ");
+  p = Format::number(p, minValue);
+  p = Format::character(p, '-');
+  p = Format::number(p, maxValue);
+  return Format::text(p, unit);
 }
 
 void Display::drawCenteredText(const char* text, int y) {
@@ -418,8 +539,9 @@ void Display::drawRightAlignedText(const char* text, int x, int y) {
 }
 
 void Display::clear() {
-  u8g2->clearBuffer();
-  u8g2->sendBuffer();
+  // Works with both full and page buffers
+  u8g2->clearDisplay();
+  invalidate();
 }
 
 void Display::setBrightness(uint8_t level) {
@@ -433,5 +555,6 @@ void Display::printStatus() const {
   DEBUG_PRINT(displayOn);
   DEBUG_PRINT_F(" Last update: ");
   DEBUG_PRINT(millis() - lastUpdate);
-  DEBUG_PRINTLN_F("ms ago");
+  DEBUG_PRINT_F("ms ago Tiles: ");
+  DEBUG_PRINTLN(tilesSent);
 }
\ No newline at end of file
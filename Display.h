@@ -3,8 +3,10 @@
 
 #include <Arduino.h>
 #include <U8g2lib.h>
+#include <util/crc16.h>
 #include "Config.h"
 #include "Icons.h"
+#include "Format.h"
 
 enum DisplayMode {
   DISPLAY_MAIN,
@@ -16,10 +18,19 @@ enum DisplayMode {
 
 // Use the HeatState enum from HeaterController.h
 
+// SH1106 driver variant selected by DISPLAY_BUFFER_MODE
+#if DISPLAY_BUFFER_MODE == 1
+  typedef U8G2_SH1106_128X64_NONAME_1_HW_I2C DisplayDriver;
+#elif DISPLAY_BUFFER_MODE == 2
+  typedef U8G2_SH1106_128X64_NONAME_2_HW_I2C DisplayDriver;
+#else
+  typedef U8G2_SH1106_128X64_NONAME_F_HW_I2C DisplayDriver;
+#endif
+
 struct DisplayData {
   // Temperature data
-  float cabinTemp;
-  float targetTemp;
+  temp_t cabinTemp;   // centi-degrees
+  temp_t targetTemp;  // centi-degrees
   
   // Time data
   uint8_t hour;
@@ -37,7 +48,7 @@ struct DisplayData {
   int menuIndex;
   int menuScrollOffset;
   int menuCount;
-  char menuItems[MAX_MENU_ITEMS][16];
+  const char* menuItems[MAX_VISIBLE_MENU_ITEMS];  // PROGMEM labels from menuScrollOffset on
   
   // Sub-menu data
   bool inSubMenu;
@@ -53,24 +64,72 @@ struct DisplayData {
   uint8_t wakeupTemp;
   uint8_t wakeupDayMask;
   
-  // Debug info
+  // Debug info (formatted only when the debug screen is drawn)
   bool showDebug;
-  char debugLine1[32];
-  char debugLine2[32];
-  char debugLine3[32];
+  uint8_t wiperValue;
+  uint8_t wiperTarget;
+  uint8_t errorFlags;  // DERR_* bits
 };
 
+// DisplayData::errorFlags bits
+#define DERR_TEMP_SENSOR 0x01
+#define DERR_RTC         0x02
+#define DERR_DISPLAY     0x04
+#define DERR_DS3502      0x08
+
+// Compact snapshot of everything that changes what is on screen, at the
+// precision it is shown. Two equal fingerprints render the same frame.
+struct DisplayFingerprint {
+  uint8_t mode;           // DisplayMode
+  int16_t cabinTemp;      // In display steps
+  int16_t targetTemp;     // In display steps
+  uint8_t hour;
+  uint8_t minute;
+  uint8_t heaterState;
+  uint8_t flags;          // DFP_* bits
+  uint16_t delaySeconds;  // 0 unless the restart delay is shown
+  uint8_t menuIndex;
+  uint8_t menuScrollOffset;
+  int16_t subMenuValue;
+  uint8_t wakeupFlowStep;
+  uint8_t wiperValue;     // Debug screen only
+  uint8_t wiperTarget;    // Debug screen only
+  uint8_t errors;         // Debug screen only: DERR_* bits
+};
+
+// DisplayFingerprint flag bits
+#define DFP_RTC_WORKING    0x01
+#define DFP_HEATER_ENABLED 0x02
+#define DFP_DELAY_ACTIVE   0x04
+#define DFP_MENU_ACTIVE    0x08
+#define DFP_IN_SUBMENU     0x10
+#define DFP_IN_WAKEUP_FLOW 0x20
+
 class Display {
 private:
   // Hardware
-  U8G2_SH1106_128X64_NONAME_F_HW_I2C* u8g2;
+  DisplayDriver* u8g2;
   
   // State
   DisplayMode currentMode;
   bool displayOn;
   unsigned long lastUpdate;
   
+  // Dirty tile tracking: CRC8 of every 8x8 tile as last sent to the panel
+  uint8_t tileCrcs[DISPLAY_TILE_COLS * DISPLAY_TILE_ROWS];
+  bool fullRefresh;  // Send every tile with the next frame
+  unsigned long lastFullRefresh;
+  uint8_t tilesSent;  // Tiles transferred by the last frame
+  
   // Internal helper methods
+  // Every draw method may run once per buffer page, so each one sets its
+  // own font and draws purely from its arguments
+  void render(const DisplayData& data);
+  void drawScreen(const DisplayData& data);
+  void drawSplashScreen();
+  void flushDirtyTiles(uint8_t firstRow, uint8_t rowCount);
+  void sendTiles(uint8_t col, uint8_t row, uint8_t count, uint8_t* rowBuffer);
+  static uint8_t tileCrc8(const uint8_t* tile);
   void drawMainScreen(const DisplayData& data);
   void drawMenuScreen(const DisplayData& data);
   void drawWakeupTimerFlow(const DisplayData& data);
@@ -84,11 +143,12 @@ private:
   void drawHeaterIcon(int x, int y, HeatState state);
   void drawDelayInfo(const DisplayData& data);
   
+  static char* formatRange(char* out, int minValue, int maxValue, const char* unit);
   void drawCenteredText(const char* text, int y);
   void drawRightAlignedText(const char* text, int x, int y);
   
 public:
-  Display(U8G2_SH1106_128X64_NONAME_F_HW_I2C* displayPtr);
+  Display(DisplayDriver* displayPtr);
   
   // Initialization
   bool begin();
@@ -99,12 +159,18 @@ public:
   void setPowerSave(bool enabled);
   bool isPowerSave() const { return currentMode == DISPLAY_POWER_SAVE; }
   
-  // Main update method
-  void update(const DisplayData& data);
+  // Main update method (returns false if throttled and nothing was drawn)
+  bool update(const DisplayData& data);
   void forceUpdate(const DisplayData& data);
   
   // Utility
   void clear();
+  void invalidate() { fullRefresh = true; }  // Resend the whole frame next update
+  bool isRefreshDue() const;  // A periodic full frame must go out even if unchanged
+  
+  // Temperature as it is shown on screen (tenths of a degree)
+  static int16_t displayedTemp(temp_t temp) { return Format::toTenths(temp); }
+  uint8_t getTilesSent() const { return tilesSent; }
   void setBrightness(uint8_t level);
   
   // Debug
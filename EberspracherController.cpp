@@ -10,20 +10,20 @@ EberspracherController::EberspracherController()
   : u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE),
     oneWire(TEMP_SENSOR_PIN),
     sensors(&oneWire),
-    button(ENCODER_SW_PIN),
+    tempSensor(&oneWire, &sensors),
     heaterController(&ds3502, HEATER_CONTROL_PIN),
-    inputHandler(&button),
+    inputHandler(),
     rtcManager(&rtc),
     display(&u8g2),
-    wakeupTimer(&rtcManager),
+    wakeupTimer(&rtcManager, &eeprom),
+    settingsStore(&eeprom),
+    displayData(),
+    lastFingerprint(),
     currentState(STATE_STARTUP),
-    currentTemp(20.0),
-    targetTemp(DEFAULT_TARGET_TEMP),
+    currentTemp(TEMP_C(20)),
+    targetTemp(TEMP_C(DEFAULT_TARGET_TEMP)),
     systemEnabled(true),
     firstRun(true),
-    lastTempRead(0),
-    lastDisplayUpdate(0),
-    lastHeaterUpdate(0),
     stateChangeTime(0),
     tempSensorError(false),
     rtcError(false),
@@ -46,6 +46,7 @@ bool EberspracherController::begin() {
   }
   
   setupMenuCallbacks();
+  setupTasks();
   changeState(STATE_NORMAL);
   
   DEBUG_PRINTLN_F("Init OK");
@@ -67,16 +68,14 @@ bool EberspracherController::setupComponents() {
   }
   
   // Initialize temperature sensors
-  sensors.begin();
-  sensors.setResolution(12);  // Maximum resolution
-  if (sensors.getDeviceCount() == 0) {
+  if (!tempSensor.begin()) {
     reportError("TempSensor", "No sensors");
     tempSensorError = true;
     success = false;
   } else {
     #if DEBUG_ENABLED
       Serial.print(F("TempSens:"));
-      Serial.println(sensors.getDeviceCount());
+      Serial.println(tempSensor.getDeviceCount());
     #endif
   }
   
@@ -87,6 +86,12 @@ bool EberspracherController::setupComponents() {
     // Non-fatal - we can continue with fallback time
   }
   
+  // Initialize wake-up timer/settings EEPROM
+  if (!eeprom.begin()) {
+    reportError("EEPROM", "Not found");
+    // Non-fatal - timers just can't be stored
+  }
+  
   // Initialize DS3502
   if (!heaterController.begin()) {
     reportError("DS3502", "Init fail");
@@ -109,6 +114,9 @@ bool EberspracherController::setupComponents() {
     // Non-fatal - we can continue without wake-up timers
   }
   
+  // Restore the last saved settings over the defaults
+  restoreSettings();
+  
   // Initialize heater timing for immediate operation
   heaterController.initializeTiming();
   
@@ -118,6 +126,7 @@ bool EberspracherController::setupComponents() {
 void EberspracherController::setupMenuCallbacks() {
   menuSystem.setHeaterCallbacks(getHeaterEnabled, setHeaterEnabled);
   menuSystem.setTargetTempCallbacks(getTargetTemp, setTargetTemp);
+  menuSystem.setControlModeCallbacks(getPiControl, setPiControl);
   menuSystem.setTimeSetCallback(enterTimeSetMode);
   menuSystem.setDebugCallback(enterDebugMode);
   menuSystem.setPowerSaveCallback(enterPowerSaveMode);
@@ -125,8 +134,24 @@ void EberspracherController::setupMenuCallbacks() {
                                      getWakeupTimerStatic, removeWakeupTimerStatic);
 }
 
+void EberspracherController::setupTasks() {
+  // Registration order must match SystemTask
+  scheduler.addTask(temperatureTask, TEMP_POLL_INTERVAL);
+  scheduler.addTask(heaterTask, HEATER_UPDATE_INTERVAL, HEATER_UPDATE_INTERVAL);
+  scheduler.addTask(displayTask, DISPLAY_UPDATE_INTERVAL);
+  scheduler.addTask(healthTask, HEALTH_CHECK_INTERVAL, HEALTH_CHECK_INTERVAL);
+  scheduler.addTask(settingsTask, SETTINGS_SAVE_DELAY);
+  scheduler.setTaskEnabled(TASK_SETTINGS, false);
+  #if PROFILER_ENABLED
+    scheduler.addTask(profilerTask, PROFILER_DUMP_INTERVAL, PROFILER_DUMP_INTERVAL);
+  #endif
+  
+  // The display task parks itself while the screen is off
+  powerManager.setWakeCallback(onPowerWake);
+}
+
 void EberspracherController::loop() {
-  const unsigned long now = millis();
+  PROFILE_SCOPE(PROF_LOOP);
   
   // Update all inputs first
   updateInputs();
@@ -135,6 +160,99 @@ void EberspracherController::loop() {
   updatePower();
   
   // State machine handling
+  runStateMachine();
+  
+  // Temperature, heater, display and health checks run on their deadlines
+  scheduler.run();
+  
+  // Step the wiper toward its target (rate-limited internally)
+  heaterController.tick();
+}
+
+void EberspracherController::idle() {
+  unsigned long wait = scheduler.getTimeUntilNextDue();
+  
+  // Power-down stops Timer0, so it is only safe with no gesture being
+  // timed, no switch debouncing and no wiper ramp in flight. Inputs are
+  // interrupt driven and wake us from it.
+  const bool quiet = !inputHandler.hasActivity() && !inputHandler.isSwitchSettling() &&
+                     heaterController.isWiperSettled();
+  if (quiet && powerManager.canPowerDown()) {
+    // An input cut the sleep short by an unknown amount: millis() is now
+    // behind, so have the software clock re-read the DS3231
+    if (!powerManager.powerDownFor(wait)) {
+      rtcManager.requestResync();
+    }
+    return;
+  }
+  
+  // Awake: keep the loop responsive while the user is interacting
+  if (wait > INPUT_POLL_INTERVAL) {
+    wait = INPUT_POLL_INTERVAL;
+  }
+  powerManager.idleFor(wait);
+}
+
+// Static task implementations
+void EberspracherController::temperatureTask() {
+  if (controllerInstance) {
+    // Advance temperature acquisition (never blocks on a conversion)
+    controllerInstance->updateTemperature();
+    
+    // Between conversions there is nothing to poll, so don't wake for it
+    const unsigned long wait = controllerInstance->tempSensor.getTimeUntilNextConversion();
+    if (wait > TEMP_POLL_INTERVAL) {
+      controllerInstance->scheduler.deferTask(TASK_TEMPERATURE, wait);
+    }
+  }
+}
+
+void EberspracherController::heaterTask() {
+  if (controllerInstance) {
+    controllerInstance->updateHeater();
+  }
+}
+
+void EberspracherController::displayTask() {
+  if (controllerInstance) {
+    controllerInstance->updateDisplay();
+  }
+}
+
+void EberspracherController::healthTask() {
+  if (controllerInstance) {
+    controllerInstance->checkSystemHealth();
+  }
+}
+
+void EberspracherController::settingsTask() {
+  if (controllerInstance) {
+    controllerInstance->saveSettings();
+    controllerInstance->scheduler.setTaskEnabled(TASK_SETTINGS, false);
+  }
+}
+
+#if PROFILER_ENABLED
+void EberspracherController::profilerTask() {
+  // Periodic dumps cover the interval since the previous one
+  PROFILE_DUMP();
+  PROFILE_RESET();
+}
+#endif
+
+void EberspracherController::runStateMachine() {
+  PROFILE_SCOPE(PROF_STATE);
+  
+  // Only wait for gestures the current screen actually handles
+  inputHandler.setGestureMask(getGestureMask());
+  
+  // Screens without encoder controls drop detents straight away: left
+  // pending they count as activity (blocking sleep) and would move the
+  // menu selection the next time it opens
+  if (currentState == STATE_NORMAL || currentState == STATE_DEBUG || currentState == STATE_ERROR) {
+    inputHandler.getRotarySteps();
+  }
+  
   switch (currentState) {
     case STATE_STARTUP:
       handleStartup();
@@ -160,28 +278,16 @@ void EberspracherController::loop() {
       handleErrorState();
       break;
   }
-  
-  // Update temperature reading
-  if (now - lastTempRead > 2000) {  // Every 2 seconds
-    updateTemperature();
-    lastTempRead = now;
-  }
-  
-  // Update heater control
-  if (now - lastHeaterUpdate > 1000) {  // Every 1 second
-    updateHeater();
-    lastHeaterUpdate = now;
-  }
-  
-  // Update display
-  if (now - lastDisplayUpdate > DISPLAY_UPDATE_INTERVAL) {
-    updateDisplay();
-    lastDisplayUpdate = now;
-  }
-  
-  // System health check
-  if (now % 10000 == 0) {  // Every 10 seconds
-    checkSystemHealth();
+}
+
+uint8_t EberspracherController::getGestureMask() const {
+  switch (currentState) {
+    case STATE_NORMAL:   return GESTURE_SHORT_PRESS;   // Open menu
+    case STATE_MENU:     return menuSystem.getGestureMask();
+    case STATE_DEBUG:    return GESTURE_LONG_PRESS;    // Leave debug
+    case STATE_TIME_SET: return GESTURE_SHORT_PRESS;   // Leave time set
+    case STATE_ERROR:    return GESTURE_LONG_PRESS;    // Attempt recovery
+    default:             return 0;
   }
 }
 
@@ -202,9 +308,11 @@ void EberspracherController::handleNormalOperation() {
 
 void EberspracherController::handleMenuOperation() {
   ButtonEvent buttonEvent = inputHandler.getButtonEvent();
-  RotaryEvent rotaryEvent = inputHandler.getRotaryEvent();
   
-  menuSystem.handleInput(rotaryEvent, buttonEvent);
+  // Consume every pending detent at once, accelerated within this screen's limit
+  int steps = inputHandler.getRotarySteps(menuSystem.getAccelerationLimit());
+  
+  menuSystem.handleInput(steps, buttonEvent);
   menuSystem.update();
   
   if (!menuSystem.isActive()) {
@@ -243,35 +351,63 @@ void EberspracherController::handleErrorState() {
 }
 
 void EberspracherController::updateTemperature() {
-  if (tempSensorError) return;
+  PROFILE_SCOPE(PROF_TEMPERATURE);
   
-  sensors.requestTemperatures();
-  float newTemp = sensors.getTempCByIndex(0);
+  // The sensor re-enumerates on its own after CRC failures or hot-plug,
+  // so keep polling it even while in error
+  tempSensor.update();
   
-  if (newTemp != DEVICE_DISCONNECTED_C && newTemp > -50 && newTemp < 100) {
-    currentTemp = newTemp;
-    tempSensorError = false;
+  if (tempSensor.hasNewSample()) {
+    // Control only ever sees the filtered value; spikes are dropped here
+    if (!tempFilter.addSample(tempSensor.getTemperature()) || !tempFilter.isReady()) {
+      return;
+    }
+    currentTemp = tempFilter.getMedian();
+    
+    // Spend conversion time only where the thermostat is about to decide
+    tempSensor.setResolution(heaterController.getRequiredResolution(currentTemp, targetTemp));
+    
+    if (tempSensorError) {
+      tempSensorError = false;
+      DEBUG_PRINTLN_F("TempSens OK");
+    }
     
     #if DEBUG_ENABLED
+      char tempStr[8];
+      Format::temperature(tempStr, currentTemp);
       Serial.print(F("T:"));
-      Serial.println(currentTemp);
+      Serial.println(tempStr);
     #endif
-  } else {
-    if (!tempSensorError) {
-      reportError("TempSensor", "Read fail");
-      tempSensorError = true;
-    }
+  } else if (tempSensor.hasError() && !tempSensorError) {
+    reportError("TempSensor", "Read fail");
+    tempSensorError = true;
   }
 }
 
 void EberspracherController::updateHeater() {
+  PROFILE_SCOPE(PROF_HEATER);
+  
+  // Wake-up timers are only evaluated when the DS3231 alarm fires, a
+  // timer changed, or one is already heating
+  if (powerManager.takeTimerWake()) {
+    wakeupTimer.handleAlarmInterrupt(1);
+  }
+  wakeupTimer.update(currentTemp);
+  
   if (ds3502Error || !systemEnabled) {
     heaterController.setMasterEnabled(false);
     return;
   }
   
   heaterController.setMasterEnabled(true);
-  heaterController.update(currentTemp, targetTemp);
+  
+  // Hold the current state until the filter has a trustworthy median
+  if (!tempFilter.isReady()) return;
+  
+  // A preheating wake-up timer overrides the manual target while it runs
+  const temp_t target = wakeupTimer.shouldHeat() ? TEMP_C(wakeupTimer.getActiveTargetTemp())
+                                                 : targetTemp;
+  heaterController.update(currentTemp, target);
   
   // Update power manager with heater state
   bool heaterOn = (heaterController.getState() != HS_OFF);
@@ -279,10 +415,15 @@ void EberspracherController::updateHeater() {
 }
 
 void EberspracherController::updateDisplay() {
+  PROFILE_SCOPE(PROF_DISPLAY);
+  
   if (displayError) return;
   
   if (powerManager.shouldDisplayBeOff()) {
+    // Nothing to draw until the next wake: stop the 200 ms tick so
+    // power-down can pick long watchdog periods (onPowerWake restarts it)
     display.setPowerSave(true);
+    scheduler.setTaskEnabled(TASK_DISPLAY, false);
     return;
   } else {
     display.setPowerSave(false);
@@ -307,11 +448,60 @@ void EberspracherController::updateDisplay() {
       break;
   }
   
-  DisplayData data = buildDisplayData();
-  display.update(data);
+  // Skip building and drawing entirely while nothing visible has changed
+  DisplayFingerprint fp;
+  buildDisplayFingerprint(fp);
+  if (!display.isRefreshDue() && memcmp(&fp, &lastFingerprint, sizeof(fp)) == 0) {
+    return;
+  }
+  
+  buildDisplayData(displayData);
+  if (display.update(displayData)) {
+    lastFingerprint = fp;
+  }
+}
+
+void EberspracherController::buildDisplayFingerprint(DisplayFingerprint& fp) {
+  memset(&fp, 0, sizeof(fp));  // Padding must compare equal too
+  
+  const DisplayMode mode = display.getMode();
+  fp.mode = mode;
+  
+  // Same rounding as the drawn text on every screen; the debug screen
+  // also shows internals
+  fp.cabinTemp = Display::displayedTemp(currentTemp);
+  if (mode == DISPLAY_DEBUG) {
+    fp.wiperValue = heaterController.getWiperValue();
+    fp.wiperTarget = heaterController.getTargetWiperValue();
+    fp.errors = getErrorFlags();
+  }
+  fp.targetTemp = Display::displayedTemp(targetTemp);
+  
+  // Minute of the day straight from the software clock (no calendar maths)
+  const uint16_t minuteOfDay = (rtcManager.getEpoch() / 60) % 1440;
+  fp.hour = minuteOfDay / 60;
+  fp.minute = minuteOfDay % 60;
+  
+  fp.heaterState = heaterController.getState();
+  if (rtcManager.isWorking()) fp.flags |= DFP_RTC_WORKING;
+  if (heaterController.isMasterEnabled()) fp.flags |= DFP_HEATER_ENABLED;
+  if (!heaterController.canTurnOn()) {
+    fp.flags |= DFP_DELAY_ACTIVE;
+    fp.delaySeconds = heaterController.getTimeUntilCanTurnOn() / 1000;
+  }
+  
+  if (menuSystem.isActive()) fp.flags |= DFP_MENU_ACTIVE;
+  if (menuSystem.isInSubMenu()) fp.flags |= DFP_IN_SUBMENU;
+  if (menuSystem.isInWakeupFlow()) fp.flags |= DFP_IN_WAKEUP_FLOW;
+  fp.menuIndex = menuSystem.getCurrentIndex();
+  fp.menuScrollOffset = menuSystem.getScrollOffset();
+  fp.subMenuValue = menuSystem.getSubMenuValue();
+  fp.wakeupFlowStep = menuSystem.getWakeupFlowStep();
 }
 
 void EberspracherController::updateInputs() {
+  PROFILE_SCOPE(PROF_INPUTS);
+  
   inputHandler.update();
   powerManager.update();
   
@@ -326,9 +516,7 @@ void EberspracherController::updatePower() {
   // This method is for future expansion
 }
 
-DisplayData EberspracherController::buildDisplayData() {
-  DisplayData data = {};
-  
+void EberspracherController::buildDisplayData(DisplayData& data) {
   // Temperature data
   data.cabinTemp = currentTemp;
   data.targetTemp = targetTemp;
@@ -365,23 +553,21 @@ DisplayData EberspracherController::buildDisplayData() {
   data.wakeupTemp = menuSystem.getWakeupTemp();
   data.wakeupDayMask = menuSystem.getWakeupDayMask();
   
-  for (int i = 0; i < data.menuCount && i < MAX_MENU_ITEMS; i++) {
-    const char* menuText = menuSystem.getMenuItemText(i);
-    strncpy_P(data.menuItems[i], menuText, 15);
-    data.menuItems[i][15] = '\0';
+  // Only the visible window of labels, as PROGMEM pointers (no copies)
+  for (int i = 0; i < MAX_VISIBLE_MENU_ITEMS; i++) {
+    data.menuItems[i] = menuSystem.getMenuItemText(data.menuScrollOffset + i);
   }
   
-  // Debug info
+  // Debug info (raw values; the debug screen formats them when drawn)
   data.showDebug = (currentState == STATE_DEBUG);
-  if (data.showDebug) {
-    snprintf(data.debugLine1, sizeof(data.debugLine1), "Temp: %.1f°C", currentTemp);
-    snprintf(data.debugLine2, sizeof(data.debugLine2), "Heater: %d Wiper: %d", 
-             (int)data.heaterState, heaterController.getWiperValue());
-    snprintf(data.debugLine3, sizeof(data.debugLine3), "Errors: T%d R%d D%d H%d", 
-             tempSensorError, rtcError, displayError, ds3502Error);
-  }
-  
-  return data;
+  data.wiperValue = heaterController.getWiperValue();
+  data.wiperTarget = heaterController.getTargetWiperValue();
+  data.errorFlags = getErrorFlags();
+}
+
+uint8_t EberspracherController::getErrorFlags() const {
+  return (tempSensorError ? DERR_TEMP_SENSOR : 0) | (rtcError ? DERR_RTC : 0) |
+         (displayError ? DERR_DISPLAY : 0) | (ds3502Error ? DERR_DS3502 : 0);
 }
 
 void EberspracherController::changeState(SystemState newState) {
@@ -398,15 +584,7 @@ void EberspracherController::changeState(SystemState newState) {
 
 void EberspracherController::checkSystemHealth() {
   // Check for persistent errors and attempt recovery
-  if (tempSensorError) {
-    // Try to re-initialize temperature sensor
-    sensors.begin();
-    if (sensors.getDeviceCount() > 0) {
-      tempSensorError = false;
-      DEBUG_PRINTLN_F("TempSens OK");
-    }
-  }
-  
+  // (temperature sensor recovery is handled by TemperatureSensor itself)
   if (rtcError && rtcManager.hasValidTime()) {
     rtcError = false;
     DEBUG_PRINTLN_F("RTC OK");
@@ -424,22 +602,36 @@ void EberspracherController::reportError(const char* component, const char* erro
 
 // Static callback implementations
 bool EberspracherController::getHeaterEnabled() {
-  return controllerInstance ? controllerInstance->heaterController.isMasterEnabled() : false;
+  return controllerInstance ? controllerInstance->systemEnabled : false;
 }
 
 void EberspracherController::setHeaterEnabled(bool enabled) {
+  // updateHeater() re-applies the master enable from systemEnabled every
+  // tick, so that is the flag to change (and to persist)
   if (controllerInstance) {
-    controllerInstance->heaterController.setMasterEnabled(enabled);
+    controllerInstance->setSystemEnabled(enabled);
   }
 }
 
-float EberspracherController::getTargetTemp() {
-  return controllerInstance ? controllerInstance->targetTemp : DEFAULT_TARGET_TEMP;
+temp_t EberspracherController::getTargetTemp() {
+  return controllerInstance ? controllerInstance->targetTemp : TEMP_C(DEFAULT_TARGET_TEMP);
 }
 
-void EberspracherController::setTargetTemp(float temp) {
+void EberspracherController::setTargetTemp(temp_t temp) {
   if (controllerInstance) {
-    controllerInstance->targetTemp = constrain(temp, MIN_TARGET_TEMP, MAX_TARGET_TEMP);
+    controllerInstance->targetTemp = constrain(temp, TEMP_C(MIN_TARGET_TEMP), TEMP_C(MAX_TARGET_TEMP));
+    controllerInstance->settingsChanged();
+  }
+}
+
+bool EberspracherController::getPiControl() {
+  return controllerInstance ? controllerInstance->heaterController.getControlMode() == CONTROL_PI : false;
+}
+
+void EberspracherController::setPiControl(bool enabled) {
+  if (controllerInstance) {
+    controllerInstance->heaterController.setControlMode(enabled ? CONTROL_PI : CONTROL_LADDER);
+    controllerInstance->settingsChanged();
   }
 }
 
@@ -451,6 +643,7 @@ void EberspracherController::enterTimeSetMode() {
 
 void EberspracherController::enterDebugMode() {
   if (controllerInstance) {
+    PROFILE_DUMP();  // On-demand dump when opening the debug screen
     controllerInstance->changeState(STATE_DEBUG);
   }
 }
@@ -461,6 +654,14 @@ void EberspracherController::enterPowerSaveMode() {
   }
 }
 
+void EberspracherController::onPowerWake() {
+  if (controllerInstance) {
+    // Redraw straight away rather than a period after the wake
+    controllerInstance->scheduler.setTaskEnabled(TASK_DISPLAY, true);
+    controllerInstance->scheduler.runTaskSoon(TASK_DISPLAY);
+  }
+}
+
 // Static wake-up timer callback implementations
 bool EberspracherController::addWakeupTimerStatic(uint8_t hour, uint8_t minute, uint8_t temp, uint8_t dayMask, const char* name) {
   if (controllerInstance) {
@@ -494,6 +695,35 @@ bool EberspracherController::removeWakeupTimerStatic(uint8_t index) {
 void EberspracherController::setSystemEnabled(bool enabled) {
   systemEnabled = enabled;
   heaterController.setMasterEnabled(enabled);
+  settingsChanged();
+}
+
+// Settings persistence
+void EberspracherController::restoreSettings() {
+  if (!settingsStore.begin()) {
+    return;  // Nothing saved yet (or no EEPROM): keep the defaults
+  }
+  
+  const PersistentSettings& saved = settingsStore.get();
+  targetTemp = constrain(saved.targetTemp, TEMP_C(MIN_TARGET_TEMP), TEMP_C(MAX_TARGET_TEMP));
+  systemEnabled = saved.heaterEnabled;
+  heaterController.setMasterEnabled(systemEnabled);
+  heaterController.setControlMode(saved.piControl ? CONTROL_PI : CONTROL_LADDER);
+}
+
+void EberspracherController::settingsChanged() {
+  // Each change restarts the wait, so scrolling through values or
+  // toggling back and forth ends up as one record
+  scheduler.setTaskEnabled(TASK_SETTINGS, true);
+  scheduler.deferTask(TASK_SETTINGS, SETTINGS_SAVE_DELAY);
+}
+
+void EberspracherController::saveSettings() {
+  PersistentSettings settings;
+  settings.targetTemp = targetTemp;
+  settings.heaterEnabled = systemEnabled;
+  settings.piControl = heaterController.getControlMode() == CONTROL_PI;
+  settingsStore.save(settings);
 }
 
 
@@ -501,11 +731,14 @@ void EberspracherController::printSystemStatus() const {
   #if DEBUG_ENABLED
     Serial.print(F("S:"));
     Serial.print(currentState);
+    char tempStr[8];
+    Format::temperature(tempStr, currentTemp);
     Serial.print(F(" T:"));
-    Serial.print(currentTemp);
+    Serial.print(tempStr);
     Serial.print(F(" E:"));
     Serial.print(tempSensorError);
     Serial.println(ds3502Error);
+    scheduler.printStatus();
   #endif
 }
 
@@ -514,9 +747,8 @@ void EberspracherController::runDiagnostics() {
     Serial.println(F("DIAG"));
     
     // Test temperature sensor
-    sensors.requestTemperatures();
-    float testTemp = sensors.getTempCByIndex(0);
-    Serial.println((testTemp != DEVICE_DISCONNECTED_C) ? F("TmpOK") : F("TmpFAIL"));
+    bool tempOk = tempSensor.readBlocking();
+    Serial.println(tempOk ? F("TmpOK") : F("TmpFAIL"));
     
     // Test RTC
     Serial.print(F("RTC:"));
@@ -527,17 +759,3 @@ void EberspracherController::runDiagnostics() {
     Serial.println(!displayError ? F("OK") : F("FAIL"));
   #endif
 }
-
-void EberspracherController::handleRotaryISR() {
-  // Read encoder state
-  static uint8_t lastClk = HIGH;
-  uint8_t clk = digitalRead(ENCODER_CLK_PIN);
-  uint8_t dt = digitalRead(ENCODER_DT_PIN);
-  
-  if (clk != lastClk) {
-    int direction = (clk == dt) ? -1 : 1;
-    inputHandler.handleRotaryInterrupt(direction);
-  }
-  
-  lastClk = clk;
-}
\ No newline at end of file
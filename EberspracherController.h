@@ -7,16 +7,33 @@
 #include <DallasTemperature.h>
 #include <RTClib.h>
 #include <Adafruit_DS3502.h>
-#include <ezButton.h>
 
 #include "Config.h"
 #include "HeaterController.h"
+#include "TemperatureSensor.h"
+#include "TempFilter.h"
 #include "InputHandler.h"
 #include "RTCManager.h"
+#include "AT24C32.h"
+#include "SettingsStore.h"
 #include "Display.h"
 #include "MenuSystem.h"
 #include "PowerManager.h"
 #include "WakeupTimer.h"
+#include "TaskScheduler.h"
+#include "LoopProfiler.h"
+
+// Scheduled tasks, in the order they are registered with the scheduler
+enum SystemTask {
+  TASK_TEMPERATURE,
+  TASK_HEATER,
+  TASK_DISPLAY,
+  TASK_HEALTH,
+  TASK_SETTINGS,   // One-shot, armed by a settings change
+#if PROFILER_ENABLED
+  TASK_PROFILER,
+#endif
+};
 
 enum SystemState {
   STATE_STARTUP,
@@ -30,14 +47,16 @@ enum SystemState {
 class EberspracherController {
 private:
   // Hardware instances
-  U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2;
+  DisplayDriver u8g2;  // Buffer size set by DISPLAY_BUFFER_MODE
   OneWire oneWire;
   DallasTemperature sensors;
   RTC_DS3231 rtc;
+  AT24C32 eeprom;  // On the DS3231 module
   Adafruit_DS3502 ds3502;
-  ezButton button;
   
   // Controller instances
+  TemperatureSensor tempSensor;
+  TempFilter tempFilter;
   HeaterController heaterController;
   InputHandler inputHandler;
   RTCManager rtcManager;
@@ -45,18 +64,21 @@ private:
   MenuSystem menuSystem;
   PowerManager powerManager;
   WakeupTimer wakeupTimer;
+  SettingsStore settingsStore;
+  TaskScheduler scheduler;
+  
+  // Display frame data, filled in place rather than built on the stack
+  DisplayData displayData;
+  DisplayFingerprint lastFingerprint;  // State behind the frame on screen
   
   // System state
   SystemState currentState;
-  float currentTemp;
-  float targetTemp;
+  temp_t currentTemp;  // centi-degrees
+  temp_t targetTemp;   // centi-degrees
   bool systemEnabled;
   bool firstRun;
   
   // Timing
-  unsigned long lastTempRead;
-  unsigned long lastDisplayUpdate;
-  unsigned long lastHeaterUpdate;
   unsigned long stateChangeTime;
   
   // Error tracking
@@ -68,6 +90,8 @@ private:
   // Internal methods
   void initializeHardware();
   bool setupComponents();
+  void runStateMachine();
+  uint8_t getGestureMask() const;  // Button gestures the current state handles
   void handleStartup();
   void handleNormalOperation();
   void handleMenuOperation();
@@ -84,17 +108,36 @@ private:
   void processRotaryInterrupt();
   void changeState(SystemState newState);
   
-  DisplayData buildDisplayData();
+  void buildDisplayData(DisplayData& data);
+  void buildDisplayFingerprint(DisplayFingerprint& fp);
+  uint8_t getErrorFlags() const;
   void setupMenuCallbacks();
+  void setupTasks();
+  void restoreSettings();
+  void settingsChanged();
+  void saveSettings();
+  
+  // Static task callbacks for the scheduler
+  static void temperatureTask();
+  static void heaterTask();
+  static void displayTask();
+  static void healthTask();
+  static void settingsTask();
+  #if PROFILER_ENABLED
+    static void profilerTask();
+  #endif
   
   // Static callback functions for menu system
   static bool getHeaterEnabled();
   static void setHeaterEnabled(bool enabled);
-  static float getTargetTemp();
-  static void setTargetTemp(float temp);
+  static temp_t getTargetTemp();
+  static void setTargetTemp(temp_t temp);
+  static bool getPiControl();
+  static void setPiControl(bool enabled);
   static void enterTimeSetMode();
   static void enterDebugMode();
   static void enterPowerSaveMode();
+  static void onPowerWake();
   
   // Static wake-up timer callbacks
   static bool addWakeupTimerStatic(uint8_t hour, uint8_t minute, uint8_t temp, uint8_t dayMask, const char* name);
@@ -112,6 +155,7 @@ public:
   // Main system control
   bool begin();
   void loop();
+  void idle();  // Sleep until the next task is due or an input arrives (call after loop())
   void shutdown();
   
   // System state
@@ -120,7 +164,7 @@ public:
   void setSystemEnabled(bool enabled);
   
   // Temperature control
-  float getCurrentTemp() const { return currentTemp; }
+  temp_t getCurrentTemp() const { return currentTemp; }
   
   // Wake-up timer control
   WakeupTimer& getWakeupTimer() { return wakeupTimer; }
@@ -128,11 +172,9 @@ public:
   bool removeWakeupTimer(uint8_t index);
   
   // Diagnostics
+  uint16_t getTaskOverruns(SystemTask task) const { return scheduler.getOverrunCount(task); }
   void printSystemStatus() const;
   void runDiagnostics();
-  
-  // ISR handlers (to be called from main sketch)
-  void handleRotaryISR();
 };
 
 // Global instance pointer for ISR access
@@ -0,0 +1,95 @@
+#include "Format.h"
+
+char* Format::text(char* out, const char* str) {
+  while (*str) {
+    *out++ = *str++;
+  }
+  *out = '\0';
+  return out;
+}
+
+char* Format::textP(char* out, const char* str) {
+  char c;
+  while ((c = pgm_read_byte(str++)) != '\0') {
+    *out++ = c;
+  }
+  *out = '\0';
+  return out;
+}
+
+char* Format::character(char* out, char c) {
+  *out++ = c;
+  *out = '\0';
+  return out;
+}
+
+char* Format::unsignedNumber(char* out, unsigned long value) {
+  // Digits come out least significant first; build them backwards
+  char digits[10];
+  uint8_t count = 0;
+  do {
+    digits[count++] = '0' + (value % 10);
+    value /= 10;
+  } while (value);
+  
+  while (count) {
+    *out++ = digits[--count];
+  }
+  *out = '\0';
+  return out;
+}
+
+char* Format::number(char* out, long value) {
+  if (value < 0) {
+    *out++ = '-';
+    return unsignedNumber(out, 0UL - (unsigned long)value);
+  }
+  return unsignedNumber(out, value);
+}
+
+char* Format::twoDigits(char* out, uint8_t value) {
+  if (value > 99) value = 99;
+  *out++ = '0' + value / 10;
+  *out++ = '0' + value % 10;
+  *out = '\0';
+  return out;
+}
+
+char* Format::tenths(char* out, int16_t tenths) {
+  // Sign goes out separately so -0.5 keeps its minus
+  unsigned int magnitude = tenths;
+  if (tenths < 0) {
+    *out++ = '-';
+    magnitude = 0U - magnitude;
+  }
+  out = unsignedNumber(out, magnitude / 10);
+  *out++ = '.';
+  *out++ = '0' + magnitude % 10;
+  *out = '\0';
+  return out;
+}
+
+int16_t Format::toTenths(temp_t centi) {
+  return (centi >= 0 ? centi + 5 : centi - 5) / 10;
+}
+
+char* Format::temperature(char* out, temp_t centi) {
+  return tenths(out, toTenths(centi));
+}
+
+char* Format::clock(char* out, uint8_t hour, uint8_t minute) {
+  out = twoDigits(out, hour);
+  *out++ = ':';
+  return twoDigits(out, minute);
+}
+
+char* Format::duration(char* out, unsigned long seconds) {
+  if (seconds > 60) {
+    out = unsignedNumber(out, seconds / 60);
+    *out++ = 'm';
+    out = twoDigits(out, seconds % 60);
+  } else {
+    out = unsignedNumber(out, seconds);
+  }
+  return character(out, 's');
+}
@@ -0,0 +1,36 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// Allocation-free number formatting for the display and logs. Replaces
+// snprintf (avr-libc's has no %f and pulls in the whole vfprintf).
+//
+// Every routine writes at the start of the caller's buffer, NUL-terminates
+// and returns a pointer to that NUL so calls chain:
+//   char* p = Format::text(buf, "T:"); p = Format::temperature(p, t);
+// The caller sizes the buffer for the longest value it can pass.
+class Format {
+public:
+  // Literal text (RAM / PROGMEM)
+  static char* text(char* out, const char* str);
+  static char* textP(char* out, const char* str);
+  static char* character(char* out, char c);
+  
+  // Integers
+  static char* unsignedNumber(char* out, unsigned long value);  // up to 10 chars
+  static char* number(char* out, long value);                   // up to 11 chars
+  static char* twoDigits(char* out, uint8_t value);             // "07"
+  
+  // Fixed point
+  static char* tenths(char* out, int16_t tenths);       // -15 → "-1.5"
+  static char* temperature(char* out, temp_t centi);    // 2147 → "21.5"
+  static int16_t toTenths(temp_t centi);                 // Rounded half away from zero
+  
+  // Time
+  static char* clock(char* out, uint8_t hour, uint8_t minute);  // "HH:MM"
+  static char* duration(char* out, unsigned long seconds);      // "4m05s" or "42s"
+};
+
+#endif // FORMAT_H
@@ -2,8 +2,9 @@
 
 HeaterController::HeaterController(Adafruit_DS3502* ds3502Ptr, int heaterControlPin)
   : ds3502(ds3502Ptr), controlPin(heaterControlPin), masterEnabled(true), 
-    currentState(HS_OFF), wiperValue(WIPER_LOW_SAFE), 
-    lastOnMs(0), lastOffMs(0), lastWiperStepMs(0) {
+    currentState(HS_OFF), controlMode(HEATER_CONTROL_MODE), wiper(ds3502Ptr), 
+    piIntegral(0), lastPiUpdateMs(0),
+    lastOnMs(0), lastOffMs(0) {
 }
 
 bool HeaterController::begin() {
@@ -18,8 +19,7 @@ bool HeaterController::begin() {
   }
   
   // Set initial safe wiper position
-  ds3502->setWiper(WIPER_LOW_SAFE);
-  wiperValue = WIPER_LOW_SAFE;
+  wiper.begin(WIPER_LOW_SAFE);
   
   DEBUG_PRINTLN("HeaterController initialized");
   return true;
@@ -45,6 +45,18 @@ void HeaterController::setMasterEnabled(bool enabled) {
   }
 }
 
+void HeaterController::setControlMode(HeaterControlMode mode) {
+  if (controlMode != mode) {
+    controlMode = mode;
+    
+    // Start the PI loop from a clean integral (bumpless from LOW)
+    piIntegral = 0;
+    lastPiUpdateMs = millis();
+    
+    DEBUG_PRINTLN(mode == CONTROL_PI ? "Heater control: PI" : "Heater control: LADDER");
+  }
+}
+
 uint8_t HeaterController::clampWiper(uint8_t value) {
   if (value < WIPER_MIN_SAFE) return WIPER_MIN_SAFE;
   if (value > WIPER_MAX_SAFE) return WIPER_MAX_SAFE;
@@ -52,60 +64,45 @@ uint8_t HeaterController::clampWiper(uint8_t value) {
 }
 
 void HeaterController::setWiperSmooth(uint8_t targetValue) {
-  targetValue = clampWiper(targetValue);
-  const unsigned long now = millis();
-  
-  // Rate limiting for smooth transitions
-  if (now - lastWiperStepMs < WIPER_STEP_DELAY_MS) return;
-  
-  if (wiperValue < targetValue) {
-    wiperValue++;
-  } else if (wiperValue > targetValue) {
-    wiperValue--;
-  } else {
-    return; // Already at target
-  }
-  
-  ds3502->setWiper(wiperValue);
-  lastWiperStepMs = now;
-  
-  #if DEBUG_HEATER
-    DEBUG_PRINT("Wiper → ");
-    DEBUG_PRINTLN(wiperValue);
-  #endif
+  // Only the target moves here; tick() walks the wiper there at the slew rate
+  wiper.setTarget(clampWiper(targetValue));
 }
 
 void HeaterController::setState(HeatState newState) {
   if (currentState == newState) return;
   
   const unsigned long now = millis();
+  const bool wasOff = (currentState == HS_OFF);
   currentState = newState;
   
+  // Minimum on-time counts from switch-on, not from power level changes
+  if (wasOff && newState != HS_OFF) {
+    lastOnMs = now;
+    piIntegral = 0;
+    lastPiUpdateMs = now;
+  }
+  
   switch (currentState) {
     case HS_OFF:
       digitalWrite(controlPin, LOW);
       lastOffMs = now;
       DEBUG_PRINTLN("Heater: OFF");
       // Park wiper at safe position
-      wiperValue = clampWiper(WIPER_LOW_SAFE);
-      ds3502->setWiper(wiperValue);
+      wiper.jumpTo(clampWiper(WIPER_LOW_SAFE));
       break;
       
     case HS_LOW:
       digitalWrite(controlPin, HIGH);
-      lastOnMs = now;
       DEBUG_PRINTLN("Heater: LOW");
       break;
       
     case HS_MED:
       digitalWrite(controlPin, HIGH);
-      lastOnMs = now;
       DEBUG_PRINTLN("Heater: MEDIUM");
       break;
       
     case HS_HIGH:
       digitalWrite(controlPin, HIGH);
-      lastOnMs = now;
       DEBUG_PRINTLN("Heater: HIGH");
       break;
   }
@@ -131,14 +128,14 @@ unsigned long HeaterController::getTimeUntilCanTurnOff() const {
   return MIN_ON_MS - elapsed;
 }
 
-void HeaterController::update(float cabinTemp, float targetTemp) {
+void HeaterController::update(temp_t cabinTemp, temp_t targetTemp) {
   // If master disabled, force OFF and return
   if (!masterEnabled) {
     setState(HS_OFF);
     return;
   }
   
-  const float diff = targetTemp - cabinTemp;  // >0 means too cold
+  const temp_t diff = targetTemp - cabinTemp;  // >0 means too cold
   HeatState desiredState = currentState;
   
   #if DEBUG_HEATER
@@ -152,30 +149,30 @@ void HeaterController::update(float cabinTemp, float targetTemp) {
     DEBUG_PRINTLN(canTurnOff());
   #endif
   
-  if (currentState == HS_OFF) {
+  // On/off decision with hysteresis and anti-chatter, shared by both modes
+  bool heaterOn = (currentState != HS_OFF);
+  if (!heaterOn) {
     // Stay OFF unless sufficiently below target and allowed to start
-    if (diff >= HYS_ON && canTurnOn()) {
-      if (diff >= DIFF_HIGH) {
-        desiredState = HS_HIGH;
-      } else if (diff >= DIFF_MED) {
-        desiredState = HS_MED;
-      } else {
-        desiredState = HS_LOW;
-      }
-    }
+    heaterOn = (diff >= HYS_ON && canTurnOn());
+  } else if (cabinTemp >= (targetTemp + HYS_OFF) && canTurnOff()) {
+    // Heater is ON: turn OFF if comfortably above target and min-on met
+    heaterOn = false;
+  }
+  
+  uint8_t targetWiper = WIPER_LOW_SAFE;  // OFF parks the wiper here
+  if (!heaterOn) {
+    desiredState = HS_OFF;
+  } else if (controlMode == CONTROL_PI) {
+    // Integral restarts on switch-on, so apply the state first
+    if (currentState == HS_OFF) setState(HS_LOW);
+    targetWiper = updatePI(diff);
+    desiredState = stateForWiper(targetWiper);
   } else {
-    // Heater is ON: consider OFF if comfortably above target and min-on met
-    if (cabinTemp >= (targetTemp + HYS_OFF) && canTurnOff()) {
-      desiredState = HS_OFF;
-    } else {
-      // Otherwise adjust power based on temperature difference
-      if (diff >= DIFF_HIGH) {
-        desiredState = HS_HIGH;
-      } else if (diff >= DIFF_MED) {
-        desiredState = HS_MED;
-      } else {
-        desiredState = HS_LOW;  // Near setpoint: hold LOW
-      }
+    desiredState = ladderState(diff);
+    switch (desiredState) {
+      case HS_MED:  targetWiper = WIPER_MED_SAFE;  break;
+      case HS_HIGH: targetWiper = WIPER_HIGH_SAFE; break;
+      default:      targetWiper = WIPER_LOW_SAFE;  break;
     }
   }
   
@@ -183,15 +180,74 @@ void HeaterController::update(float cabinTemp, float targetTemp) {
   setState(desiredState);
   
   // Drive wiper smoothly toward target for current state
-  uint8_t targetWiper = wiperValue;
-  switch (currentState) {
-    case HS_LOW:  targetWiper = WIPER_LOW_SAFE;  break;
-    case HS_MED:  targetWiper = WIPER_MED_SAFE;  break;
-    case HS_HIGH: targetWiper = WIPER_HIGH_SAFE; break;
-    case HS_OFF:  targetWiper = WIPER_LOW_SAFE;  break;
+  setWiperSmooth(targetWiper);
+}
+
+HeatState HeaterController::ladderState(temp_t diff) const {
+  // Power level from temperature difference
+  if (diff >= DIFF_HIGH) return HS_HIGH;
+  if (diff >= DIFF_MED) return HS_MED;
+  return HS_LOW;  // Near setpoint: hold LOW
+}
+
+uint8_t HeaterController::updatePI(temp_t diff) {
+  const unsigned long now = millis();
+  unsigned long dt = now - lastPiUpdateMs;
+  lastPiUpdateMs = now;
+  if (dt > PI_MAX_DT_MS) dt = PI_MAX_DT_MS;
+  
+  // Everything in Q16 wiper steps, centred on the LOW level at zero error
+  const int32_t base = (int32_t)WIPER_LOW_SAFE << 16;
+  const int32_t outMin = (int32_t)WIPER_MIN_SAFE << 16;
+  const int32_t outMax = (int32_t)WIPER_MAX_SAFE << 16;
+  const int32_t pTerm = (int32_t)diff * PI_KP_Q16;
+  const int32_t output = base + pTerm + piIntegral;
+  
+  // Anti-windup: stop integrating while the output is pinned at a limit
+  // and the error would drive it further, and bound the integral itself
+  const bool pinnedHigh = (output >= outMax && diff > 0);
+  const bool pinnedLow = (output <= outMin && diff < 0);
+  if (!pinnedHigh && !pinnedLow) {
+    piIntegral += (int32_t)diff * PI_KI_Q16 * (int32_t)dt / 1000;
+    piIntegral = constrain(piIntegral, outMin - base, outMax - base);
   }
   
-  setWiperSmooth(targetWiper);
+  int32_t wiper = constrain(base + pTerm + piIntegral, outMin, outMax);
+  return (uint8_t)((wiper + 0x8000L) >> 16);
+}
+
+HeatState HeaterController::stateForWiper(uint8_t wiper) {
+  // Nearest ladder level, for display and status only
+  if (wiper >= (WIPER_MED_SAFE + WIPER_HIGH_SAFE + 1) / 2) return HS_HIGH;
+  if (wiper >= (WIPER_LOW_SAFE + WIPER_MED_SAFE + 1) / 2) return HS_MED;
+  return HS_LOW;
+}
+
+uint8_t HeaterController::getRequiredResolution(temp_t cabinTemp, temp_t targetTemp) const {
+  const temp_t diff = targetTemp - cabinTemp;
+  temp_t margin;
+  
+  if (currentState == HS_OFF) {
+    // Only the turn-on threshold matters, and only once a start is allowed
+    if (!masterEnabled || !canTurnOn()) return 9;
+    margin = abs(diff - HYS_ON);
+  } else {
+    // PI acts on the error itself; the ladder only at its level boundaries.
+    // Either way turn-off matters once the minimum on-time is met.
+    if (controlMode == CONTROL_PI) {
+      margin = abs(diff);
+    } else {
+      margin = min(abs(diff - DIFF_MED), abs(diff - DIFF_HIGH));
+    }
+    if (canTurnOff()) {
+      margin = min(margin, abs(diff + HYS_OFF));
+    }
+  }
+  
+  if (margin < RES_BAND_12BIT) return 12;
+  if (margin < RES_BAND_11BIT) return 11;
+  if (margin < RES_BAND_10BIT) return 10;
+  return 9;
 }
 
 void HeaterController::printStatus() const {
@@ -200,7 +256,9 @@ void HeaterController::printStatus() const {
   DEBUG_PRINT(" State: ");
   DEBUG_PRINT(currentState);
   DEBUG_PRINT(" Wiper: ");
-  DEBUG_PRINT(wiperValue);
+  DEBUG_PRINT(wiper.getCommanded());
+  DEBUG_PRINT("/");
+  DEBUG_PRINT(wiper.getTarget());
   DEBUG_PRINT(" canTurnOn: ");
   DEBUG_PRINT(canTurnOn());
   DEBUG_PRINT(" canTurnOff: ");
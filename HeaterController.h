@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include <Adafruit_DS3502.h>
 #include "Config.h"
+#include "WiperRamp.h"
 
 class HeaterController {
 private:
@@ -14,17 +15,24 @@ private:
   // State management
   bool masterEnabled;
   HeatState currentState;
-  uint8_t wiperValue;
+  HeaterControlMode controlMode;
+  WiperRamp wiper;
+  
+  // PI controller state
+  int32_t piIntegral;            // Integral term, Q16 wiper steps
+  unsigned long lastPiUpdateMs;
   
   // Timing for anti-chatter logic
   unsigned long lastOnMs;
   unsigned long lastOffMs;
-  unsigned long lastWiperStepMs;
   
   // Internal helper methods
   uint8_t clampWiper(uint8_t value);
   void setWiperSmooth(uint8_t targetValue);
   void setState(HeatState newState);
+  HeatState ladderState(temp_t diff) const;
+  uint8_t updatePI(temp_t diff);
+  static HeatState stateForWiper(uint8_t wiper);
   
 public:
   HeaterController(Adafruit_DS3502* ds3502Ptr, int heaterControlPin);
@@ -37,9 +45,14 @@ public:
   void setMasterEnabled(bool enabled);
   bool isMasterEnabled() const { return masterEnabled; }
   
+  // Power control strategy (ladder or PI)
+  void setControlMode(HeaterControlMode mode);
+  HeaterControlMode getControlMode() const { return controlMode; }
+  
   // State and status
   HeatState getState() const { return currentState; }
-  uint8_t getWiperValue() const { return wiperValue; }
+  uint8_t getWiperValue() const { return wiper.getCommanded(); }       // On the DS3502 now
+  uint8_t getTargetWiperValue() const { return wiper.getTarget(); }   // Where the ramp is heading
   
   // Timing constraints
   bool canTurnOn() const;
@@ -47,8 +60,15 @@ public:
   unsigned long getTimeUntilCanTurnOn() const;
   unsigned long getTimeUntilCanTurnOff() const;
   
+  // Wiper ramp (call every loop; cheap when settled)
+  void tick() { wiper.tick(); }
+  bool isWiperSettled() const { return wiper.isSettled(); }
+  
   // Main control logic
-  void update(float cabinTemp, float targetTemp);
+  void update(temp_t cabinTemp, temp_t targetTemp);  // centi-degrees
+  
+  // Sensor bit depth needed to resolve the next decision
+  uint8_t getRequiredResolution(temp_t cabinTemp, temp_t targetTemp) const;
   
   // Debug information
   void printStatus() const;
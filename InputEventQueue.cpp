@@ -0,0 +1,53 @@
+#include "InputEventQueue.h"
+#include <util/atomic.h>
+
+static_assert((INPUT_QUEUE_SIZE & (INPUT_QUEUE_SIZE - 1)) == 0, "INPUT_QUEUE_SIZE must be a power of two");
+
+// Stops the compiler moving slot accesses across an index update
+#define QUEUE_BARRIER() asm volatile("" ::: "memory")
+
+InputEventQueue::InputEventQueue() : head(0), tail(0), overflows(0) {
+}
+
+bool InputEventQueue::push(uint8_t type, int8_t value, uint16_t time) {
+  const uint8_t h = head;
+  const uint8_t next = (h + 1) & (INPUT_QUEUE_SIZE - 1);
+  
+  // One slot stays empty so full and empty can be told apart
+  if (next == tail) {
+    if (overflows < 0xFFFF) overflows++;
+    return false;
+  }
+  
+  events[h].type = type;
+  events[h].value = value;
+  events[h].time = time;
+  QUEUE_BARRIER();
+  head = next;  // Publish only once the slot is complete
+  return true;
+}
+
+bool InputEventQueue::pop(InputEvent& event) {
+  const uint8_t t = tail;
+  if (t == head) return false;
+  
+  QUEUE_BARRIER();
+  event = events[t];
+  QUEUE_BARRIER();
+  tail = (t + 1) & (INPUT_QUEUE_SIZE - 1);  // Hand the slot back
+  return true;
+}
+
+uint16_t InputEventQueue::getOverflowCount() const {
+  uint16_t count;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    count = overflows;  // Two bytes: must not tear against the ISR
+  }
+  return count;
+}
+
+void InputEventQueue::resetOverflowCount() {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    overflows = 0;
+  }
+}
@@ -0,0 +1,47 @@
+#ifndef INPUT_EVENT_QUEUE_H
+#define INPUT_EVENT_QUEUE_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+enum InputEventType {
+  INPUT_ROTARY,       // value: +1 clockwise / -1 counter-clockwise detent
+  INPUT_BUTTON_DOWN,
+  INPUT_BUTTON_UP
+};
+
+// One input edge, stamped with the low 16 bits of millis() where it was
+// seen (intervals up to ~65 s are exact with unsigned subtraction)
+struct InputEvent {
+  uint8_t type;   // InputEventType
+  int8_t value;
+  uint16_t time;
+};
+
+// Fixed-capacity single-producer/single-consumer ring. Interrupt context
+// (which never nests on AVR) is the producer, the main loop the consumer.
+// Head and tail are single bytes, so each side publishes its index with
+// one atomic store and neither side ever disables interrupts.
+class InputEventQueue {
+private:
+  InputEvent events[INPUT_QUEUE_SIZE];
+  volatile uint8_t head;       // Next slot to write (producer only)
+  volatile uint8_t tail;       // Next slot to read (consumer only)
+  volatile uint16_t overflows;  // Events dropped because the ring was full
+
+public:
+  InputEventQueue();
+  
+  // Producer side: interrupt context, or main loop with interrupts masked
+  bool push(uint8_t type, int8_t value, uint16_t time);
+  
+  // Consumer side: main loop only
+  bool pop(InputEvent& event);
+  bool isEmpty() const { return head == tail; }
+  
+  // Status
+  uint16_t getOverflowCount() const;
+  void resetOverflowCount();
+};
+
+#endif // INPUT_EVENT_QUEUE_H
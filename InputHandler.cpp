@@ -1,116 +1,272 @@
 #include "InputHandler.h"
+#include "PowerManager.h"
 
-InputHandler::InputHandler(ezButton* buttonPtr)
-  : button(buttonPtr), rotaryDelta(0), lastRotaryTime(0),
-    pressStartTime(0), lastReleaseTime(0), longPressTriggered(false),
-    waitingForDoubleClick(false), lastActivityTime(0) {
+// Static instance pointer for ISR access
+static InputHandler* inputHandlerInstance = nullptr;
+
+// Quadrature transition table indexed by (previous state << 2) | new state,
+// with state = (CLK << 1) | DT. Valid Gray-code moves give ±1; no change and
+// impossible double transitions (a missed edge or bounce) give 0.
+static const int8_t QUADRATURE_TABLE[16] PROGMEM = {
+   0, -1,  1,  0,
+   1,  0,  0, -1,
+  -1,  0,  0,  1,
+   0,  1, -1,  0
+};
+
+InputHandler::InputHandler()
+  : encoderState(0), encoderSteps(0), pendingRotary(0),
+    switchPressed(false), switchRawPressed(false), switchStableTicks(0),
+    lastDetentTime(0), lastDirection(0), rotaryMultiplier(1),
+    pressStartTime(0), lastReleaseTime(0), buttonDown(false), longPressTriggered(false),
+    waitingForDoubleClick(false), gestureMask(GESTURE_ALL), pendingButton(BUTTON_NONE),
+    lastActivityTime(0) {
+  inputHandlerInstance = this;
 }
 
 void InputHandler::begin() {
-  // Initialize button
-  button->setDebounceTime(DEBOUNCE_TIME);
-  
-  // Initialize rotary encoder pins
+  // Initialize rotary encoder pins (the switch is active low)
   pinMode(ENCODER_CLK_PIN, INPUT);
   pinMode(ENCODER_DT_PIN, INPUT);
+  pinMode(ENCODER_SW_PIN, INPUT_PULLUP);
+  
+  // Timer0 already runs at ~1 kHz for millis(); its compare-B interrupt is
+  // the debounce tick, enabled only while the switch is settling. Mid-count
+  // keeps it clear of the overflow ISR. (OC0B is the switch pin, an input,
+  // so the compare output itself is unused.)
+  OCR0B = 0x80;
+  
+  // Watch both encoder pins and the switch via the pin-change interrupt,
+  // which also wakes the MCU from power-down
+  const uint8_t pins = ENCODER_PIN_REG;
+  encoderState = (((pins >> ENCODER_CLK_BIT) & 1) << 1) | ((pins >> ENCODER_DT_BIT) & 1);
+  switchPressed = switchRawPressed = !(pins & _BV(ENCODER_SW_BIT));
+  ENCODER_PCMSK |= _BV(ENCODER_CLK_BIT) | _BV(ENCODER_DT_BIT) | _BV(ENCODER_SW_BIT);
+  PCICR |= _BV(ENCODER_PCIE);
   
   recordActivity();
   DEBUG_PRINTLN("InputHandler initialized");
 }
 
 void InputHandler::update() {
-  button->loop();  // Update ezButton state
+  // Drain everything that arrived since the last pass in one go
+  InputEvent event;
+  while (eventQueue.pop(event)) {
+    switch (event.type) {
+      case INPUT_ROTARY:
+        handleRotaryEvent(event);
+        break;
+        
+      case INPUT_BUTTON_DOWN:
+      case INPUT_BUTTON_UP:
+        handleButtonEdge(event);
+        break;
+    }
+  }
+  
+  checkButtonTimers(millis());
 }
 
-void InputHandler::handleRotaryInterrupt(int direction) {
-  const unsigned long now = millis();
+void InputHandler::handleEncoderInterrupt() {
+  // Runs on every edge of either pin: one port read and a table lookup.
+  // Bounce just walks back and forth through the table and cancels out.
+  const uint8_t pins = ENCODER_PIN_REG;
+  const uint8_t state = (((pins >> ENCODER_CLK_BIT) & 1) << 1) | ((pins >> ENCODER_DT_BIT) & 1);
+  if (state == encoderState) return;  // Edge on another PCINT2 pin
+  
+  encoderSteps += (int8_t)pgm_read_byte(&QUADRATURE_TABLE[(encoderState << 2) | state]);
+  encoderState = state;
   
-  // Debounce rotary encoder
-  if ((now - lastRotaryTime) < DEBOUNCE_TIME) return;
+  if (encoderSteps >= ENCODER_STEPS_PER_DETENT || encoderSteps <= -ENCODER_STEPS_PER_DETENT) {
+    eventQueue.push(INPUT_ROTARY, encoderSteps > 0 ? 1 : -1, millis());
+    encoderSteps = 0;
+    powerRotaryISR();
+  }
+}
+
+void InputHandler::handleSwitchInterrupt() {
+  // Every edge, bounce included, restarts the settle count; the tick
+  // decides once the level has held still
+  const bool pressed = !(ENCODER_PIN_REG & _BV(ENCODER_SW_BIT));
+  if (pressed == switchRawPressed) return;  // Edge on an encoder pin
+  
+  switchRawPressed = pressed;
+  switchStableTicks = 0;
+  TIMSK0 |= _BV(OCIE0B);
+  powerButtonISR();
+}
+
+void InputHandler::handleDebounceTick() {
+  const bool pressed = !(ENCODER_PIN_REG & _BV(ENCODER_SW_BIT));
+  
+  if (pressed == switchPressed) {
+    // Bounced back to where it was: nothing happened
+    TIMSK0 &= ~_BV(OCIE0B);
+    return;
+  }
   
-  rotaryDelta += direction;
-  lastRotaryTime = now;
+  if (++switchStableTicks >= BUTTON_DEBOUNCE_TICKS) {
+    switchPressed = pressed;
+    eventQueue.push(pressed ? INPUT_BUTTON_DOWN : INPUT_BUTTON_UP, 0, millis());
+    TIMSK0 &= ~_BV(OCIE0B);
+  }
+}
+
+// Encoder pins, switch and the DS3231 alarm line share PCINT2 (PD0-PD7)
+ISR(PCINT2_vect) {
+  if (inputHandlerInstance) {
+    inputHandlerInstance->handleEncoderInterrupt();
+    inputHandlerInstance->handleSwitchInterrupt();
+  }
+  
+  // Held low until the alarm flag is cleared over I2C
+  if (!(RTC_INT_PIN_REG & _BV(RTC_INT_BIT))) {
+    powerAlarmISR();
+  }
+}
+
+// Switch debounce tick, only enabled while the switch is settling
+ISR(TIMER0_COMPB_vect) {
+  if (inputHandlerInstance) {
+    inputHandlerInstance->handleDebounceTick();
+  }
+}
+
+void InputHandler::handleRotaryEvent(const InputEvent& event) {
+  pendingRotary += event.value;
+  updateVelocity(event.value, event.time);
   recordActivity();
   
   #if DEBUG_INPUT
     DEBUG_PRINT("Rotary: ");
-    DEBUG_PRINTLN(direction > 0 ? "CW" : "CCW");
+    DEBUG_PRINTLN(event.value > 0 ? "CW" : "CCW");
   #endif
 }
 
-ButtonEvent InputHandler::checkButtonEvent() {
-  if (button->isPressed()) {
-    pressStartTime = millis();
+void InputHandler::updateVelocity(int8_t direction, uint16_t time) {
+  // Exact per-detent interval from the ISR timestamps
+  uint16_t interval = time - lastDetentTime;
+  lastDetentTime = time;
+  
+  // Reversing direction always starts again at single steps
+  if (direction != lastDirection) {
+    interval = ENCODER_ACCEL_SLOW_MS;
+  }
+  lastDirection = direction;
+  
+  // Linear ramp from 1 (slow turns) to ENCODER_ACCEL_MAX (fast spins)
+  if (interval >= ENCODER_ACCEL_SLOW_MS) {
+    rotaryMultiplier = 1;
+  } else if (interval <= ENCODER_ACCEL_FAST_MS) {
+    rotaryMultiplier = ENCODER_ACCEL_MAX;
+  } else {
+    rotaryMultiplier = 1 + (ENCODER_ACCEL_SLOW_MS - interval) * (ENCODER_ACCEL_MAX - 1) /
+                           (ENCODER_ACCEL_SLOW_MS - ENCODER_ACCEL_FAST_MS);
+  }
+}
+
+void InputHandler::handleButtonEdge(const InputEvent& event) {
+  recordActivity();
+  
+  if (event.type == INPUT_BUTTON_DOWN) {
+    pressStartTime = event.time;
+    buttonDown = true;
     longPressTriggered = false;
-    recordActivity();
     
     #if DEBUG_INPUT
       DEBUG_PRINTLN("Button pressed");
     #endif
+    return;
   }
   
-  if (button->isReleased()) {
-    unsigned long pressDuration = millis() - pressStartTime;
-    lastReleaseTime = millis();
-    recordActivity();
-    
-    #if DEBUG_INPUT
-      DEBUG_PRINT("Button released after ");
-      DEBUG_PRINT(pressDuration);
-      DEBUG_PRINTLN("ms");
-    #endif
-    
-    if (longPressTriggered) {
-      // Long press already handled during press
-      return BUTTON_NONE;
-    }
-    
-    if (pressDuration >= BUTTON_LONG_PRESS_TIME) {
-      return BUTTON_LONG_PRESS;
-    }
-    
-    // Check for double click
-    if (waitingForDoubleClick) {
-      waitingForDoubleClick = false;
-      return BUTTON_DOUBLE_CLICK;
-    } else {
-      waitingForDoubleClick = true;
-      return BUTTON_NONE; // Wait to see if double click comes
-    }
+  uint16_t pressDuration = event.time - pressStartTime;
+  lastReleaseTime = event.time;
+  buttonDown = false;
+  
+  #if DEBUG_INPUT
+    DEBUG_PRINT("Button released after ");
+    DEBUG_PRINT(pressDuration);
+    DEBUG_PRINTLN("ms");
+  #endif
+  
+  if (longPressTriggered) {
+    // Long press already handled during press
+    return;
   }
   
+  if ((gestureMask & GESTURE_LONG_PRESS) && pressDuration >= BUTTON_LONG_PRESS_TIME) {
+    reportGesture(BUTTON_LONG_PRESS, GESTURE_LONG_PRESS);
+    return;
+  }
+  
+  // Nobody listens for double clicks: report the click now, not 300 ms later
+  if (!(gestureMask & GESTURE_DOUBLE_CLICK)) {
+    reportGesture(BUTTON_SHORT_PRESS, GESTURE_SHORT_PRESS);
+    return;
+  }
+  
+  // Check for double click
+  if (waitingForDoubleClick) {
+    waitingForDoubleClick = false;
+    reportGesture(BUTTON_DOUBLE_CLICK, GESTURE_DOUBLE_CLICK);
+  } else {
+    waitingForDoubleClick = true;  // Wait to see if double click comes
+  }
+}
+
+void InputHandler::checkButtonTimers(uint16_t now) {
   // Check for long press during hold
-  if (button->getState() == LOW && !longPressTriggered) {
-    unsigned long pressDuration = millis() - pressStartTime;
-    if (pressDuration >= BUTTON_LONG_PRESS_TIME) {
-      longPressTriggered = true;
-      return BUTTON_LONG_PRESS;
-    }
+  if (buttonDown && !longPressTriggered && (gestureMask & GESTURE_LONG_PRESS) &&
+      (uint16_t)(now - pressStartTime) >= BUTTON_LONG_PRESS_TIME) {
+    longPressTriggered = true;
+    reportGesture(BUTTON_LONG_PRESS, GESTURE_LONG_PRESS);
   }
   
   // Handle double click timeout
-  if (waitingForDoubleClick && 
-      (millis() - lastReleaseTime) > BUTTON_DOUBLE_CLICK_TIME) {
+  if (waitingForDoubleClick &&
+      (uint16_t)(now - lastReleaseTime) > BUTTON_DOUBLE_CLICK_TIME) {
     waitingForDoubleClick = false;
-    return BUTTON_SHORT_PRESS;
+    reportGesture(BUTTON_SHORT_PRESS, GESTURE_SHORT_PRESS);
+  }
+}
+
+void InputHandler::reportGesture(ButtonEvent event, uint8_t gesture) {
+  if (gestureMask & gesture) {
+    pendingButton = event;
   }
+}
+
+void InputHandler::setGestureMask(uint8_t mask) {
+  if (mask == gestureMask) return;
+  gestureMask = mask;
   
-  return BUTTON_NONE;
+  // Anything recognised so far belonged to the previous screen
+  waitingForDoubleClick = false;
+  pendingButton = BUTTON_NONE;
 }
 
 RotaryEvent InputHandler::checkRotaryEvent() {
-  if (rotaryDelta > 0) {
-    rotaryDelta--;
+  if (pendingRotary > 0) {
+    pendingRotary--;
     return ROTARY_CW;
-  } else if (rotaryDelta < 0) {
-    rotaryDelta++;
+  } else if (pendingRotary < 0) {
+    pendingRotary++;
     return ROTARY_CCW;
   }
   return ROTARY_NONE;
 }
 
+int InputHandler::getRotarySteps(uint8_t maxMultiplier) {
+  const uint8_t multiplier = min(rotaryMultiplier, max(maxMultiplier, (uint8_t)1));
+  const int steps = pendingRotary * multiplier;
+  pendingRotary = 0;
+  return steps;
+}
+
 ButtonEvent InputHandler::getButtonEvent() {
-  return checkButtonEvent();
+  ButtonEvent event = pendingButton;
+  pendingButton = BUTTON_NONE;
+  return event;
 }
 
 RotaryEvent InputHandler::getRotaryEvent() {
@@ -119,8 +275,8 @@ RotaryEvent InputHandler::getRotaryEvent() {
 
 bool InputHandler::hasActivity() {
   // Check if there's any pending input
-  return (rotaryDelta != 0) || (button->getState() == LOW) || 
-         waitingForDoubleClick;
+  return (pendingRotary != 0) || buttonDown || waitingForDoubleClick ||
+         !eventQueue.isEmpty();
 }
 
 void InputHandler::recordActivity() {
@@ -129,9 +285,11 @@ void InputHandler::recordActivity() {
 
 void InputHandler::printStatus() const {
   DEBUG_PRINT("InputHandler - Button: ");
-  DEBUG_PRINT(button->getState());
+  DEBUG_PRINT(switchPressed);
   DEBUG_PRINT(" Rotary: ");
-  DEBUG_PRINT(rotaryDelta);
+  DEBUG_PRINT(pendingRotary);
+  DEBUG_PRINT(" Dropped: ");
+  DEBUG_PRINT(getDroppedEventCount());
   DEBUG_PRINT(" Activity: ");
   DEBUG_PRINT(millis() - lastActivityTime);
   DEBUG_PRINTLN("ms ago");
@@ -2,8 +2,8 @@
 #define INPUT_HANDLER_H
 
 #include <Arduino.h>
-#include <ezButton.h>
 #include "Config.h"
+#include "InputEventQueue.h"
 
 enum ButtonEvent {
   BUTTON_NONE,
@@ -12,6 +12,14 @@ enum ButtonEvent {
   BUTTON_DOUBLE_CLICK
 };
 
+// Gesture subscription bits: a screen only pays for the gestures it uses.
+// Without GESTURE_DOUBLE_CLICK a short press fires on release; without
+// GESTURE_LONG_PRESS any release counts as a short press.
+const uint8_t GESTURE_SHORT_PRESS = 0x01;
+const uint8_t GESTURE_LONG_PRESS = 0x02;
+const uint8_t GESTURE_DOUBLE_CLICK = 0x04;
+const uint8_t GESTURE_ALL = GESTURE_SHORT_PRESS | GESTURE_LONG_PRESS | GESTURE_DOUBLE_CLICK;
+
 enum RotaryEvent {
   ROTARY_NONE,
   ROTARY_CW,     // Clockwise
@@ -20,26 +28,46 @@ enum RotaryEvent {
 
 class InputHandler {
 private:
-  // Hardware
-  ezButton* button;
-  volatile int rotaryDelta;
-  volatile unsigned long lastRotaryTime;
+  // Timestamped input edges, pushed from interrupt context, drained by update()
+  InputEventQueue eventQueue;
+  
+  // Quadrature decoder (owned by the pin-change ISR)
+  uint8_t encoderState;         // (CLK << 1) | DT at the last edge
+  int8_t encoderSteps;          // Transitions since the last whole detent
+  int pendingRotary;            // Detents drained, waiting to be consumed
+  
+  // Switch debouncer (owned by the pin-change and Timer0 compare ISRs)
+  volatile bool switchPressed;  // Debounced switch level
+  bool switchRawPressed;        // Level at the last pin-change
+  uint8_t switchStableTicks;    // Ticks the raw level has differed and held
   
-  // Button state tracking
-  unsigned long pressStartTime;
-  unsigned long lastReleaseTime;
+  // Acceleration
+  uint16_t lastDetentTime;      // Event timestamp of the previous detent
+  int8_t lastDirection;
+  uint8_t rotaryMultiplier;     // From the most recent detent interval
+  
+  // Button state tracking (event timestamps)
+  uint16_t pressStartTime;
+  uint16_t lastReleaseTime;
+  bool buttonDown;
   bool longPressTriggered;
   bool waitingForDoubleClick;
+  uint8_t gestureMask;          // GESTURE_* bits the current screen listens for
+  ButtonEvent pendingButton;    // Recognised gesture not yet read
   
   // Activity tracking
   unsigned long lastActivityTime;
   
   // Internal helper methods
-  ButtonEvent checkButtonEvent();
+  void handleRotaryEvent(const InputEvent& event);
+  void handleButtonEdge(const InputEvent& event);
+  void checkButtonTimers(uint16_t now);
+  void reportGesture(ButtonEvent event, uint8_t gesture);
   RotaryEvent checkRotaryEvent();
+  void updateVelocity(int8_t direction, uint16_t time);
   
 public:
-  InputHandler(ezButton* buttonPtr);
+  InputHandler();
   
   // Initialization
   void begin();
@@ -47,17 +75,28 @@ public:
   // Main update method (call frequently)
   void update();
   
+  // Gesture subscription (GESTURE_* bits); pending gestures are dropped on change
+  void setGestureMask(uint8_t mask);
+  uint8_t getGestureMask() const { return gestureMask; }
+  
   // Event checking
   ButtonEvent getButtonEvent();
-  RotaryEvent getRotaryEvent();
+  RotaryEvent getRotaryEvent();                    // One unscaled detent per call
+  int getRotarySteps(uint8_t maxMultiplier = 1);   // All pending detents, accelerated
   bool hasActivity();
+  bool isSwitchSettling() const { return TIMSK0 & _BV(OCIE0B); }  // Debounce tick running
   
   // Activity tracking
   unsigned long getLastActivityTime() const { return lastActivityTime; }
   void recordActivity();
   
-  // ISR handlers (called from main sketch)
-  void handleRotaryInterrupt(int direction);
+  // Input events dropped because the queue was full
+  uint16_t getDroppedEventCount() const { return eventQueue.getOverflowCount(); }
+  
+  // ISR handlers (pin-change interrupt on the encoder port, Timer0 compare B)
+  void handleEncoderInterrupt();
+  void handleSwitchInterrupt();
+  void handleDebounceTick();
   
   // Debug
   void printStatus() const;
@@ -0,0 +1,77 @@
+#include "LoopProfiler.h"
+
+#if PROFILER_ENABLED
+
+StageStats LoopProfiler::stats[PROF_STAGE_COUNT];
+
+uint8_t LoopProfiler::bucketFor(uint32_t us) {
+  uint8_t bucket = 0;
+  us >>= 4;  // First bucket is < 16 µs
+  while (us && bucket < PROF_BUCKET_COUNT - 1) {
+    us >>= 2;
+    bucket++;
+  }
+  return bucket;
+}
+
+void LoopProfiler::record(uint8_t stage, uint32_t us) {
+  if (stage >= PROF_STAGE_COUNT) return;
+  StageStats& s = stats[stage];
+  
+  if (s.count == 0 || us < s.minUs) s.minUs = us;
+  if (us > s.maxUs) s.maxUs = us;
+  
+  // Keep the mean meaningful on long runs by halving sum and count together
+  if (s.count == 0xFFFF || s.sumUs > 0xFFFFFFFFUL - us) {
+    s.sumUs >>= 1;
+    s.count >>= 1;
+  }
+  s.sumUs += us;
+  s.count++;
+  
+  uint16_t& bucket = s.buckets[bucketFor(us)];
+  if (bucket < 0xFFFF) bucket++;
+}
+
+void LoopProfiler::reset() {
+  memset(stats, 0, sizeof(stats));
+}
+
+const __FlashStringHelper* LoopProfiler::stageName(uint8_t stage) {
+  switch (stage) {
+    case PROF_LOOP:        return F("loop");
+    case PROF_INPUTS:      return F("input");
+    case PROF_STATE:       return F("state");
+    case PROF_TEMPERATURE: return F("temp");
+    case PROF_HEATER:      return F("heat");
+    case PROF_DISPLAY:     return F("disp");
+    default:               return F("?");
+  }
+}
+
+void LoopProfiler::dump() {
+  // Format: name n min/avg/max us | histogram buckets
+  for (uint8_t i = 0; i < PROF_STAGE_COUNT; i++) {
+    const StageStats& s = stats[i];
+    
+    Serial.print(F("P:"));
+    Serial.print(stageName(i));
+    Serial.print(F(" n"));
+    Serial.print(s.count);
+    Serial.print(' ');
+    Serial.print(s.minUs);
+    Serial.print('/');
+    Serial.print(s.count ? s.sumUs / s.count : 0);
+    Serial.print('/');
+    Serial.print(s.maxUs);
+    Serial.print(F(" |"));
+    
+    for (uint8_t b = 0; b < PROF_BUCKET_COUNT; b++) {
+      Serial.print(' ');
+      Serial.print(s.buckets[b]);
+    }
+    Serial.println();
+  }
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,73 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// Loop stages timed by the profiler
+enum ProfileStage {
+  PROF_LOOP,         // Whole controller loop() pass
+  PROF_INPUTS,       // updateInputs()
+  PROF_STATE,        // State machine / menu handling
+  PROF_TEMPERATURE,  // updateTemperature()
+  PROF_HEATER,       // updateHeater()
+  PROF_DISPLAY,      // updateDisplay() including sendBuffer()
+  PROF_STAGE_COUNT
+};
+
+#if PROFILER_ENABLED
+
+// Histogram buckets are powers of four in µs: <16, <64, <256, <1k, <4k,
+// <16k, <64k and everything slower
+const uint8_t PROF_BUCKET_COUNT = 8;
+
+struct StageStats {
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint32_t sumUs;    // Halved together with count before it can overflow
+  uint16_t count;
+  uint16_t buckets[PROF_BUCKET_COUNT];
+};
+
+// Compile-time enabled per-stage latency profiler. All state is static so
+// the PROFILE_* macros can be dropped anywhere without plumbing.
+class LoopProfiler {
+private:
+  static StageStats stats[PROF_STAGE_COUNT];
+  
+  static uint8_t bucketFor(uint32_t us);
+  static const __FlashStringHelper* stageName(uint8_t stage);
+
+public:
+  static void record(uint8_t stage, uint32_t us);
+  static void reset();
+  static void dump();  // Print every stage over serial
+};
+
+// Times the enclosing scope
+class ProfileScope {
+private:
+  uint8_t stage;
+  unsigned long start;
+
+public:
+  ProfileScope(uint8_t s) : stage(s), start(micros()) {}
+  ~ProfileScope() { LoopProfiler::record(stage, micros() - start); }
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(stage) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(stage)
+#define PROFILE_DUMP() LoopProfiler::dump()
+#define PROFILE_RESET() LoopProfiler::reset()
+
+#else
+
+// Profiler disabled: the macros vanish entirely
+#define PROFILE_SCOPE(stage)
+#define PROFILE_DUMP()
+#define PROFILE_RESET()
+
+#endif // PROFILER_ENABLED
+
+#endif // LOOP_PROFILER_H
@@ -11,6 +11,7 @@ MenuSystem::MenuSystem()
     wakeupDayMask(0x3E), wakeupFlowStep(0),
     heaterEnabledCallback(nullptr), setHeaterEnabledCallback(nullptr),
     getTargetTempCallback(nullptr), setTargetTempCallback(nullptr),
+    piControlCallback(nullptr), setPiControlCallback(nullptr),
     enterTimeSetCallback(nullptr), enterDebugCallback(nullptr),
     enterPowerSaveCallback(nullptr), addWakeupTimerCallback(nullptr),
     getWakeupTimerCountCallback(nullptr), getWakeupTimerCallback(nullptr),
@@ -27,26 +28,28 @@ void MenuSystem::begin() {
 // Store menu strings in flash memory (shortened to save space)
 const char menuStr0[] PROGMEM = "Heater On/Off";
 const char menuStr1[] PROGMEM = "Set Target";
-const char menuStr2[] PROGMEM = "Wakeup Timers";
-const char menuStr3[] PROGMEM = "Add Timer";
-const char menuStr4[] PROGMEM = "View Timers";
-const char menuStr5[] PROGMEM = "Set Time";
-const char menuStr6[] PROGMEM = "Debug";
-const char menuStr7[] PROGMEM = "Sleep";
-const char menuStr8[] PROGMEM = "Exit";
+const char menuStr2[] PROGMEM = "PI Ctrl On/Off";
+const char menuStr3[] PROGMEM = "Wakeup Timers";
+const char menuStr4[] PROGMEM = "Add Timer";
+const char menuStr5[] PROGMEM = "View Timers";
+const char menuStr6[] PROGMEM = "Set Time";
+const char menuStr7[] PROGMEM = "Debug";
+const char menuStr8[] PROGMEM = "Sleep";
+const char menuStr9[] PROGMEM = "Exit";
 
 void MenuSystem::initializeMenuItems() {
   menuItems[0] = {MENU_HEATER_TOGGLE, menuStr0, alwaysEnabled, nullptr};
   menuItems[1] = {MENU_SET_TARGET, menuStr1, alwaysEnabled, nullptr};
-  menuItems[2] = {MENU_WAKEUP_TIMERS, menuStr2, alwaysEnabled, nullptr};
-  menuItems[3] = {MENU_ADD_WAKEUP, menuStr3, alwaysEnabled, nullptr};
-  menuItems[4] = {MENU_VIEW_WAKEUPS, menuStr4, alwaysEnabled, nullptr};
-  menuItems[5] = {MENU_SET_TIME, menuStr5, alwaysEnabled, nullptr};
-  menuItems[6] = {MENU_DEBUG_INFO, menuStr6, alwaysEnabled, nullptr};
-  menuItems[7] = {MENU_POWER_SAVE, menuStr7, alwaysEnabled, nullptr};
-  menuItems[8] = {MENU_EXIT, menuStr8, alwaysEnabled, nullptr};
+  menuItems[2] = {MENU_CONTROL_MODE, menuStr2, alwaysEnabled, nullptr};
+  menuItems[3] = {MENU_WAKEUP_TIMERS, menuStr3, alwaysEnabled, nullptr};
+  menuItems[4] = {MENU_ADD_WAKEUP, menuStr4, alwaysEnabled, nullptr};
+  menuItems[5] = {MENU_VIEW_WAKEUPS, menuStr5, alwaysEnabled, nullptr};
+  menuItems[6] = {MENU_SET_TIME, menuStr6, alwaysEnabled, nullptr};
+  menuItems[7] = {MENU_DEBUG_INFO, menuStr7, alwaysEnabled, nullptr};
+  menuItems[8] = {MENU_POWER_SAVE, menuStr8, alwaysEnabled, nullptr};
+  menuItems[9] = {MENU_EXIT, menuStr9, alwaysEnabled, nullptr};
   
-  menuItemCount = 9;
+  menuItemCount = 10;
 }
 
 void MenuSystem::setHeaterCallbacks(bool (*getEnabled)(), void (*setEnabled)(bool)) {
@@ -54,11 +57,16 @@ void MenuSystem::setHeaterCallbacks(bool (*getEnabled)(), void (*setEnabled)(boo
   setHeaterEnabledCallback = setEnabled;
 }
 
-void MenuSystem::setTargetTempCallbacks(float (*getTemp)(), void (*setTemp)(float)) {
+void MenuSystem::setTargetTempCallbacks(temp_t (*getTemp)(), void (*setTemp)(temp_t)) {
   getTargetTempCallback = getTemp;
   setTargetTempCallback = setTemp;
 }
 
+void MenuSystem::setControlModeCallbacks(bool (*getPiEnabled)(), void (*setPiEnabled)(bool)) {
+  piControlCallback = getPiEnabled;
+  setPiControlCallback = setPiEnabled;
+}
+
 void MenuSystem::setTimeSetCallback(void (*enterTimeSet)()) {
   enterTimeSetCallback = enterTimeSet;
 }
@@ -105,32 +113,54 @@ void MenuSystem::closeMenu() {
   }
 }
 
-void MenuSystem::handleInput(RotaryEvent rotaryEvent, ButtonEvent buttonEvent) {
+void MenuSystem::handleInput(int steps, ButtonEvent buttonEvent) {
   if (!menuActive) return;
   
   recordActivity();
   
   if (inWakeupTimerFlow) {
-    handleWakeupTimerFlow(rotaryEvent, buttonEvent);
+    handleWakeupTimerFlow(steps, buttonEvent);
   } else if (inSubMenu) {
-    handleSubMenuNavigation(rotaryEvent, buttonEvent);
+    handleSubMenuNavigation(steps, buttonEvent);
   } else {
-    handleMainMenuNavigation(rotaryEvent, buttonEvent);
+    handleMainMenuNavigation(steps, buttonEvent);
   }
 }
 
-void MenuSystem::handleMainMenuNavigation(RotaryEvent rotaryEvent, ButtonEvent buttonEvent) {
-  // Handle rotary encoder for menu navigation
-  if (rotaryEvent == ROTARY_CW) {
-    currentIndex = (currentIndex + 1) % menuItemCount;
-    updateScrollPosition();
-    
-    #if DEBUG_INPUT
-      DEBUG_PRINT("Menu index: ");
-      DEBUG_PRINTLN(currentIndex);
-    #endif
-  } else if (rotaryEvent == ROTARY_CCW) {
-    currentIndex = (currentIndex - 1 + menuItemCount) % menuItemCount;
+uint8_t MenuSystem::getAccelerationLimit() const {
+  if (!inSubMenu) return 1;  // List navigation never skips items
+  
+  // Roughly a tenth of each range per fast detent
+  switch (activeSubMenu) {
+    case MENU_SET_TARGET:        return 3;   // 5-40°C
+    case MENU_WAKEUP_SET_HOUR:   return 3;   // 0-23
+    case MENU_WAKEUP_SET_MINUTE: return 6;   // 0-59
+    case MENU_WAKEUP_SET_TEMP:   return 2;   // 15-30°C
+    default:                     return 1;   // Small choice lists
+  }
+}
+
+uint8_t MenuSystem::getGestureMask() const {
+  // The list, the value editors and the wake-up flow all confirm with a
+  // click and back out with a hold. None of them use double-click, so
+  // clicks are delivered on release.
+  return GESTURE_SHORT_PRESS | GESTURE_LONG_PRESS;
+}
+
+void MenuSystem::adjustSubMenuValue(int steps) {
+  if (steps == 0) return;
+  subMenuValue = constrain(subMenuValue + steps, subMenuMin, subMenuMax);
+  
+  #if DEBUG_INPUT
+    DEBUG_PRINT("SubMenu value: ");
+    DEBUG_PRINTLN(subMenuValue);
+  #endif
+}
+
+void MenuSystem::handleMainMenuNavigation(int steps, ButtonEvent buttonEvent) {
+  // Handle rotary encoder for menu navigation (wraps around both ends)
+  if (steps != 0) {
+    currentIndex = ((currentIndex + steps) % menuItemCount + menuItemCount) % menuItemCount;
     updateScrollPosition();
     
     #if DEBUG_INPUT
@@ -147,23 +177,9 @@ void MenuSystem::handleMainMenuNavigation(RotaryEvent rotaryEvent, ButtonEvent b
   }
 }
 
-void MenuSystem::handleSubMenuNavigation(RotaryEvent rotaryEvent, ButtonEvent buttonEvent) {
+void MenuSystem::handleSubMenuNavigation(int steps, ButtonEvent buttonEvent) {
   // Handle rotary encoder for value adjustment
-  if (rotaryEvent == ROTARY_CW && subMenuValue < subMenuMax) {
-    subMenuValue++;
-    
-    #if DEBUG_INPUT
-      DEBUG_PRINT("SubMenu value: ");
-      DEBUG_PRINTLN(subMenuValue);
-    #endif
-  } else if (rotaryEvent == ROTARY_CCW && subMenuValue > subMenuMin) {
-    subMenuValue--;
-    
-    #if DEBUG_INPUT
-      DEBUG_PRINT("SubMenu value: ");
-      DEBUG_PRINTLN(subMenuValue);
-    #endif
-  }
+  adjustSubMenuValue(steps);
   
   // Handle button events
   if (buttonEvent == BUTTON_SHORT_PRESS) {
@@ -171,7 +187,7 @@ void MenuSystem::handleSubMenuNavigation(RotaryEvent rotaryEvent, ButtonEvent bu
     switch (activeSubMenu) {
       case MENU_SET_TARGET:
         if (setTargetTempCallback) {
-          setTargetTempCallback((float)subMenuValue);
+          setTargetTempCallback(TEMP_C(subMenuValue));
           #if DEBUG_ENABLED
             Serial.print(F("Tgt:"));
             Serial.println(subMenuValue);
@@ -205,13 +221,23 @@ void MenuSystem::executeMenuItem(MenuId id) {
       if (getTargetTempCallback) {
         inSubMenu = true;
         activeSubMenu = MENU_SET_TARGET;
-        subMenuValue = (int)getTargetTempCallback();
+        subMenuValue = getTargetTempCallback() / TEMP_SCALE;
         subMenuMin = MIN_TARGET_TEMP;
         subMenuMax = MAX_TARGET_TEMP;
         DEBUG_PRINTLN_F("TgtSubMenu");
       }
       break;
       
+    case MENU_CONTROL_MODE:
+      if (piControlCallback && setPiControlCallback) {
+        bool piEnabled = piControlCallback();
+        setPiControlCallback(!piEnabled);
+        DEBUG_PRINT("PI control: ");
+        DEBUG_PRINTLN(!piEnabled);
+      }
+      closeMenu();
+      break;
+      
     case MENU_WAKEUP_TIMERS:
       // TODO: Implement wake-up timer main menu
       DEBUG_PRINTLN_F("WakeMenu TODO");
@@ -318,10 +344,12 @@ void MenuSystem::updateScrollPosition() {
 }
 
 const char* MenuSystem::getMenuItemText(int index) const {
+  // Always a PROGMEM string, so callers can read it with the _P functions
+  static const char emptyStr[] PROGMEM = "";
   if (index >= 0 && index < menuItemCount) {
     return menuItems[index].text;
   }
-  return "";
+  return emptyStr;
 }
 
 bool MenuSystem::isMenuItemEnabled(int index) const {
@@ -375,13 +403,9 @@ void MenuSystem::startWakeupTimerFlow() {
   DEBUG_PRINTLN_F("WakeFlow+");
 }
 
-void MenuSystem::handleWakeupTimerFlow(RotaryEvent rotaryEvent, ButtonEvent buttonEvent) {
+void MenuSystem::handleWakeupTimerFlow(int steps, ButtonEvent buttonEvent) {
   // Handle rotary input for current step
-  if (rotaryEvent == ROTARY_CW && subMenuValue < subMenuMax) {
-    subMenuValue++;
-  } else if (rotaryEvent == ROTARY_CCW && subMenuValue > subMenuMin) {
-    subMenuValue--;
-  }
+  adjustSubMenuValue(steps);
   
   // Handle button input
   if (buttonEvent == BUTTON_SHORT_PRESS) {
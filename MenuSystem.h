@@ -9,6 +9,7 @@ enum MenuId {
   MENU_MAIN = 0,
   MENU_HEATER_TOGGLE,
   MENU_SET_TARGET,
+  MENU_CONTROL_MODE,      // Toggle ladder / PI heater control
   MENU_WAKEUP_TIMERS,     // Main wake-up timer menu
   MENU_ADD_WAKEUP,        // Add new wake-up timer
   MENU_VIEW_WAKEUPS,      // View/edit existing timers
@@ -67,8 +68,10 @@ private:
   // Callbacks for external state
   bool (*heaterEnabledCallback)();
   void (*setHeaterEnabledCallback)(bool enabled);
-  float (*getTargetTempCallback)();
-  void (*setTargetTempCallback)(float temp);
+  temp_t (*getTargetTempCallback)();
+  void (*setTargetTempCallback)(temp_t temp);
+  bool (*piControlCallback)();
+  void (*setPiControlCallback)(bool enabled);
   void (*enterTimeSetCallback)();
   void (*enterDebugCallback)();
   void (*enterPowerSaveCallback)();
@@ -81,9 +84,10 @@ private:
   
   // Internal helper methods
   void initializeMenuItems();
-  void handleMainMenuNavigation(RotaryEvent rotaryEvent, ButtonEvent buttonEvent);
-  void handleSubMenuNavigation(RotaryEvent rotaryEvent, ButtonEvent buttonEvent);
-  void handleWakeupTimerFlow(RotaryEvent rotaryEvent, ButtonEvent buttonEvent);
+  void handleMainMenuNavigation(int steps, ButtonEvent buttonEvent);
+  void handleSubMenuNavigation(int steps, ButtonEvent buttonEvent);
+  void handleWakeupTimerFlow(int steps, ButtonEvent buttonEvent);
+  void adjustSubMenuValue(int steps);
   void executeMenuItem(MenuId id);
   void exitSubMenu();
   void startWakeupTimerFlow();
@@ -108,7 +112,8 @@ public:
   
   // Callback registration
   void setHeaterCallbacks(bool (*getEnabled)(), void (*setEnabled)(bool));
-  void setTargetTempCallbacks(float (*getTemp)(), void (*setTemp)(float));
+  void setTargetTempCallbacks(temp_t (*getTemp)(), void (*setTemp)(temp_t));
+  void setControlModeCallbacks(bool (*getPiEnabled)(), void (*setPiEnabled)(bool));
   void setTimeSetCallback(void (*enterTimeSet)());
   void setDebugCallback(void (*enterDebug)());
   void setPowerSaveCallback(void (*enterPowerSave)());
@@ -126,14 +131,16 @@ public:
   bool isInSubMenu() const { return inSubMenu; }
   MenuId getActiveSubMenu() const { return activeSubMenu; }
   
-  // Input handling
-  void handleInput(RotaryEvent rotaryEvent, ButtonEvent buttonEvent);
+  // Input handling (steps: signed, already-accelerated encoder delta)
+  void handleInput(int steps, ButtonEvent buttonEvent);
+  uint8_t getAccelerationLimit() const;  // Max step multiplier for the active screen
+  uint8_t getGestureMask() const;        // GESTURE_* bits the active screen handles
   
   // Menu data for display
   int getCurrentIndex() const { return currentIndex; }
   int getScrollOffset() const { return scrollOffset; }
   int getMenuItemCount() const { return menuItemCount; }
-  const char* getMenuItemText(int index) const;
+  const char* getMenuItemText(int index) const;  // PROGMEM string
   bool isMenuItemEnabled(int index) const;
   
   // Sub-menu data for display
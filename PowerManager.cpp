@@ -1,4 +1,9 @@
 #include "PowerManager.h"
+#include <util/atomic.h>
+
+// Arduino core millisecond counter (wiring.c); Timer0 is stopped in
+// power-down, so the time slept is added back by hand
+extern volatile unsigned long timer0_millis;
 
 // Static instance pointer for ISR access
 static PowerManager* powerManagerInstance = nullptr;
@@ -7,7 +12,8 @@ PowerManager::PowerManager()
   : currentState(POWER_ACTIVE), lastActivityTime(0), lastWakeTime(0),
     lastWakeupReason(WAKE_UNKNOWN), sleepEnabled(true), heaterRunning(false),
     displayOffTimeout(POWER_SAVE_TIMEOUT), lightSleepTimeout(60000), deepSleepTimeout(300000),
-    buttonWakeFlag(false), rotaryWakeFlag(false), timerWakeFlag(false) {
+    buttonWakeFlag(false), rotaryWakeFlag(false), timerWakeFlag(false), watchdogFired(false),
+    sleptMs(0), pinWakeups(0), wakeCallback(nullptr) {
   powerManagerInstance = this;
 }
 
@@ -41,8 +47,7 @@ void PowerManager::setHeaterRunning(bool running) {
   
   // If heater is running, prevent deep sleep
   if (running && currentState == POWER_DEEP_SLEEP) {
-    currentState = POWER_LIGHT_SLEEP;
-    wakeUp();
+    wakeUp();  // Restores peripherals; update() drops back to light sleep
   }
 }
 
@@ -106,12 +111,6 @@ void PowerManager::update() {
     recordRotaryActivity();
   }
   
-  if (timerWakeFlag) {
-    timerWakeFlag = false;
-    lastWakeupReason = WAKE_TIMER;
-    recordActivity();
-  }
-  
   // Determine appropriate power state
   PowerState newState = POWER_ACTIVE;
   
@@ -146,31 +145,82 @@ void PowerManager::update() {
   }
 }
 
-void PowerManager::enterLightSleep() {
-  currentState = POWER_LIGHT_SLEEP;
-  DEBUG_PRINTLN("Entering light sleep");
+void PowerManager::idleFor(unsigned long ms) {
+  // SLEEP_MODE_IDLE only stops the CPU clock: Timer0 wakes us every ~1 ms,
+  // so millis(), serial and pin interrupts behave as with delay()
+  const unsigned long start = millis();
+  set_sleep_mode(SLEEP_MODE_IDLE);
   
-  // Setup interrupts for wake-up
-  attachInterrupt(digitalPinToInterrupt(ENCODER_SW_PIN), powerButtonISR, FALLING);
-  attachInterrupt(digitalPinToInterrupt(ENCODER_CLK_PIN), powerRotaryISR, CHANGE);
+  while (millis() - start < ms) {
+    sleep_enable();
+    sleep_cpu();
+    sleep_disable();
+  }
+}
+
+bool PowerManager::canPowerDown() const {
+  // Only once the user has walked away; while the display is on the loop
+  // stays in IDLE so menus and redraws keep their timing
+  return sleepEnabled && (currentState == POWER_LIGHT_SLEEP || currentState == POWER_DEEP_SLEEP);
+}
+
+bool PowerManager::powerDownFor(unsigned long ms) {
+  if (ms < POWER_DOWN_MIN_MS) {
+    idleFor(ms);
+    return true;
+  }
   
-  // Setup watchdog for periodic wake-up (8 seconds)
-  setupWatchdog(WDTO_8S);
+  // Longest watchdog period that still fits: 16 ms << n, n = 0..9 (8 s)
+  uint8_t n = 0;
+  while (n < 9 && (POWER_DOWN_MIN_MS << (n + 1)) <= ms) {
+    n++;
+  }
+  const unsigned long period = POWER_DOWN_MIN_MS << n;
   
-  // Enter power-down sleep mode
-  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+  // The UART stops with the clock: let pending debug output finish first
+  #if DEBUG_ENABLED
+    Serial.flush();
+  #endif
+  
+  // Watchdog in interrupt mode (not reset) for one period
   cli();
+  wdt_reset();
+  MCUSR &= ~_BV(WDRF);
+  WDTCSR = _BV(WDCE) | _BV(WDE);
+  WDTCSR = _BV(WDIE) | (n & 0x07) | ((n & 0x08) ? _BV(WDP3) : 0);
+  watchdogFired = false;
+  
+  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
   sleep_enable();
-  sei();
+  sleep_bod_disable();
+  sei();        // The instruction after sei() always runs, so no wake-up is lost
   sleep_cpu();
   sleep_disable();
-  
-  // Clean up after wake
-  detachInterrupt(digitalPinToInterrupt(ENCODER_SW_PIN));
-  detachInterrupt(digitalPinToInterrupt(ENCODER_CLK_PIN));
   disableWatchdog();
   
-  wakeUp();
+  if (watchdogFired) {
+    // Credit slightly less than nominal: a slow millis() only ever
+    // stretches MIN_ON_MS / MIN_OFF_MS, a fast one would cut them short
+    const unsigned long credit = period * WDT_CREDIT_PERCENT / 100;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      timer0_millis += credit;
+    }
+    sleptMs += credit;
+    return true;
+  }
+  
+  // Woken by an input; how far into the period is unknown, so credit
+  // nothing rather than risk running the clock ahead
+  if (pinWakeups < 0xFFFF) pinWakeups++;
+  return false;
+}
+
+void PowerManager::enterLightSleep() {
+  currentState = POWER_LIGHT_SLEEP;
+  DEBUG_PRINTLN("Entering light sleep");
+  
+  // The gaps between tasks are now spent in power-down (see powerDownFor);
+  // the encoder and switch pin-change interrupt wakes us from it
 }
 
 void PowerManager::enterDeepSleep() {
@@ -179,34 +229,21 @@ void PowerManager::enterDeepSleep() {
   
   // Disable more peripherals for maximum power saving
   disableUnusedPeripherals();
-  
-  // Setup interrupts for wake-up
-  attachInterrupt(digitalPinToInterrupt(ENCODER_SW_PIN), powerButtonISR, FALLING);
-  
-  // Setup watchdog for longer periodic wake-up (8 seconds, but we'll count cycles)
-  setupWatchdog(WDTO_8S);
-  
-  // Enter deepest sleep mode
-  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
-  cli();
-  sleep_enable();
-  sei();
-  sleep_cpu();
-  sleep_disable();
-  
-  // Clean up after wake
-  detachInterrupt(digitalPinToInterrupt(ENCODER_SW_PIN));
-  disableWatchdog();
-  enableRequiredPeripherals();
-  
-  wakeUp();
 }
 
 void PowerManager::wakeUp() {
+  if (currentState == POWER_DEEP_SLEEP) {
+    enableRequiredPeripherals();
+  }
+  
   if (currentState != POWER_ACTIVE) {
     currentState = POWER_ACTIVE;
     lastWakeTime = millis();
     
+    if (wakeCallback) {
+      wakeCallback();
+    }
+    
     #if DEBUG_ENABLED
       DEBUG_PRINT("Woke up: ");
       switch (lastWakeupReason) {
@@ -267,6 +304,10 @@ void PowerManager::forceWakeUp() {
   wakeUp();
 }
 
+void PowerManager::setWakeCallback(void (*onWake)()) {
+  wakeCallback = onWake;
+}
+
 void PowerManager::setDisplayOffTimeout(unsigned long timeout) {
   displayOffTimeout = timeout;
 }
@@ -279,6 +320,15 @@ void PowerManager::setDeepSleepTimeout(unsigned long timeout) {
   deepSleepTimeout = timeout;
 }
 
+bool PowerManager::takeTimerWake() {
+  if (!timerWakeFlag) return false;
+  
+  // A wake-up timer starting is not user activity: the display stays off
+  timerWakeFlag = false;
+  lastWakeupReason = WAKE_TIMER;
+  return true;
+}
+
 void PowerManager::handleButtonInterrupt() {
   buttonWakeFlag = true;
 }
@@ -288,6 +338,11 @@ void PowerManager::handleRotaryInterrupt() {
 }
 
 void PowerManager::handleWatchdogInterrupt() {
+  // Only times a power-down; not user activity, so no wake flag
+  watchdogFired = true;
+}
+
+void PowerManager::handleAlarmInterrupt() {
   timerWakeFlag = true;
 }
 
@@ -313,6 +368,10 @@ void PowerManager::printPowerStats() const {
   DEBUG_PRINTLN("ms");
   DEBUG_PRINT("  Last wake reason: ");
   DEBUG_PRINTLN(lastWakeupReason);
+  DEBUG_PRINT("  Power-down: ");
+  DEBUG_PRINT(sleptMs);
+  DEBUG_PRINT("ms, input wakes: ");
+  DEBUG_PRINTLN(pinWakeups);
 }
 
 // ISR implementations
@@ -334,9 +393,15 @@ extern "C" {
       powerManagerInstance->handleWatchdogInterrupt();
     }
   }
+  
+  void powerAlarmISR() {
+    if (powerManagerInstance) {
+      powerManagerInstance->handleAlarmInterrupt();
+    }
+  }
 }
 
-// Watchdog ISR (comment out if not using watchdog)
-// ISR(WDT_vect) {
-//   powerWatchdogISR();
-// }
\ No newline at end of file
+// Watchdog in interrupt mode times power-down
+ISR(WDT_vect) {
+  powerWatchdogISR();
+}
\ No newline at end of file
@@ -40,7 +40,15 @@ private:
   // Wake-up tracking
   volatile bool buttonWakeFlag;
   volatile bool rotaryWakeFlag;
-  volatile bool timerWakeFlag;
+  volatile bool timerWakeFlag;   // RTC alarm line went low
+  volatile bool watchdogFired;  // The last power-down ended on the watchdog
+  
+  // Power-down accounting
+  unsigned long sleptMs;        // Time credited to millis() across power-downs
+  uint16_t pinWakeups;          // Power-downs cut short by an interrupt
+  
+  // Called on every return to POWER_ACTIVE
+  void (*wakeCallback)();
   
   // Power reduction methods
   void disableUnusedPeripherals();
@@ -83,6 +91,14 @@ public:
   bool shouldEnterLightSleep() const;
   bool shouldEnterDeepSleep() const;
   
+  // Idle the CPU (timers and interrupts keep running) for up to ms
+  void idleFor(unsigned long ms);
+  
+  // Power-down for up to ms: watchdog-timed, woken early by pin interrupts.
+  // millis() is advanced for the time slept (never past real time).
+  bool canPowerDown() const;
+  bool powerDownFor(unsigned long ms);  // False if an interrupt ended it early
+  
   // Manual power control
   void forceDisplayOff();
   void forceLightSleep();
@@ -91,17 +107,20 @@ public:
   
   // Wake-up information
   WakeupReason getLastWakeupReason() const { return lastWakeupReason; }
+  bool takeTimerWake();  // True once per RTC alarm interrupt
   unsigned long getTimeSinceWake() const;
   
   // Configuration
   void setDisplayOffTimeout(unsigned long timeout);
   void setLightSleepTimeout(unsigned long timeout);
   void setDeepSleepTimeout(unsigned long timeout);
+  void setWakeCallback(void (*onWake)());
   
   // ISR handlers (called from main sketch)
   void handleButtonInterrupt();
   void handleRotaryInterrupt();
   void handleWatchdogInterrupt();
+  void handleAlarmInterrupt();
   
   // Debug
   void printStatus() const;
@@ -113,6 +132,7 @@ extern "C" {
   void powerButtonISR();
   void powerRotaryISR();
   void powerWatchdogISR();
+  void powerAlarmISR();
 }
 
 #endif // POWER_MANAGER_H
\ No newline at end of file
@@ -2,8 +2,9 @@
 
 RTCManager::RTCManager(RTC_DS3231* rtcPtr)
   : rtc(rtcPtr), rtcInitialized(false), rtcWorking(true),
-    lastGoodYear(2024), lastGoodMonth(1), lastGoodDay(1),
-    lastGoodHour(12), lastGoodMinute(0), lastRtcRead(0) {
+    clockEpoch(DateTime(2024, 1, 1, 12, 0, 0).unixtime()), clockMillis(0), lastSync(0),
+    clockSet(false), resyncRequested(false), lastDrift(0),
+    rejectedEpoch(0), rejectedMillis(0), rejectedSet(false), confirmPending(false) {
 }
 
 bool RTCManager::begin() {
@@ -16,6 +17,20 @@ bool RTCManager::begin() {
   
   rtcInitialized = true;
   
+  // INT/SQW is the alarm line (INTCN set), not a square wave. Stale alarms
+  // from before a reset are dropped; WakeupTimer programs its own.
+  rtc->writeSqwPinMode(DS3231_OFF);
+  rtc->disableAlarm(1);
+  rtc->disableAlarm(2);
+  rtc->clearAlarm(1);
+  rtc->clearAlarm(2);
+  
+  // The line idles high and is pulled low while an enabled alarm flag is
+  // set; the pin-change interrupt wakes the MCU from power-down on it
+  pinMode(RTC_INT_PIN, INPUT_PULLUP);
+  RTC_INT_PCMSK |= _BV(RTC_INT_BIT);
+  PCICR |= _BV(RTC_INT_PCIE);
+  
   if (rtc->lostPower()) {
     DEBUG_PRINTLN(F("RTC lost pwr"));
     setTimeFromCompile();
@@ -24,14 +39,11 @@ bool RTCManager::begin() {
   // Wait a moment for RTC to stabilize
   delay(100);
   
-  // Test RTC by getting initial time
-  DateTime now = rtc->now();
-  if (isValidTime(now)) {
-    storeGoodTime(now);
-    rtcWorking = true;
+  // Test RTC by getting initial time (this also sets the software clock)
+  syncFromChip();
+  if (rtcWorking) {
     DEBUG_PRINTLN(F("RTC OK"));
   } else {
-    rtcWorking = false;
     DEBUG_PRINTLN(F("RTC bad time"));
   }
   
@@ -69,19 +81,10 @@ bool RTCManager::isValidTime(DateTime dt) const {
 
 bool RTCManager::isReasonableTimeChange(DateTime newTime) const {
   // If we don't have a reference, accept first valid time
-  if (lastRtcRead == 0) return true;
-  
-  // Calculate expected time progression
-  unsigned long elapsedMs = millis() - lastRtcRead;
-  unsigned long expectedMinuteChange = elapsedMs / 60000; // minutes
-  
-  // Create expected time based on last good time + elapsed
-  DateTime expected(lastGoodYear, lastGoodMonth, lastGoodDay,
-                    lastGoodHour, lastGoodMinute, 0);
-  expected = expected + TimeSpan(0, 0, expectedMinuteChange, 0);
+  if (!clockSet) return true;
   
-  // Check if new time is within reasonable range
-  long timeDiff = abs((long)newTime.unixtime() - (long)expected.unixtime());
+  // The software clock is the expected time
+  long timeDiff = labs((long)(newTime.unixtime() - softwareEpoch()));
   bool reasonable = (timeDiff < RTC_TIME_JUMP_THRESHOLD);
   
   #if DEBUG_RTC
@@ -95,58 +98,94 @@ bool RTCManager::isReasonableTimeChange(DateTime newTime) const {
   return reasonable;
 }
 
-void RTCManager::storeGoodTime(DateTime dt) {
-  lastGoodYear = dt.year();
-  lastGoodMonth = dt.month();
-  lastGoodDay = dt.day();
-  lastGoodHour = dt.hour();
-  lastGoodMinute = dt.minute();
-  lastRtcRead = millis();
+bool RTCManager::confirmsRejectedTime(uint32_t chipEpoch) const {
+  if (!rejectedSet) return false;
+  
+  // The chip advanced by the time that passed since the rejected read
+  const long expected = rejectedEpoch + (millis() - rejectedMillis) / 1000;
+  return labs((long)chipEpoch - expected) <= RTC_CONFIRM_TOLERANCE;
 }
 
-DateTime RTCManager::getFallbackTime() const {
-  return DateTime(lastGoodYear, lastGoodMonth, lastGoodDay,
-                  lastGoodHour, lastGoodMinute, 0);
+uint32_t RTCManager::softwareEpoch() const {
+  return clockEpoch + (millis() - clockMillis) / 1000;
 }
 
-DateTime RTCManager::getStableTime() {
-  if (!rtcInitialized) {
-    // RTC not available, use stored fallback
-    rtcWorking = false;
-    return getFallbackTime();
+void RTCManager::setClock(uint32_t epoch) {
+  clockEpoch = epoch;
+  clockMillis = millis();
+  clockSet = true;
+}
+
+void RTCManager::syncFromChip() {
+  lastSync = millis();
+  resyncRequested = false;
+  
+  DateTime chip = rtc->now();
+  const bool valid = isValidTime(chip);
+  
+  // While the chip is marked bad the software clock has been drifting,
+  // so it is no reference: two consistent reads in a row are
+  bool accepted = valid && isReasonableTimeChange(chip);
+  if (valid && !accepted && !rtcWorking && confirmsRejectedTime(chip.unixtime())) {
+    accepted = true;
   }
   
-  DateTime now = rtc->now();
-  
-  if (isValidTime(now) && isReasonableTimeChange(now)) {
-    // Time is valid and reasonable - store it
-    storeGoodTime(now);
-    rtcWorking = true;
-    return now;
-  } else {
-    // Time is invalid or jumping - use stored time
+  if (!accepted) {
+    // Time is invalid or jumping - keep free-running on millis(), rebased
+    // so the elapsed count never gets near rollover
     rtcWorking = false;
+    confirmPending = valid && !confirmPending;  // One quick re-read per rejection
+    rejectedSet = valid;
+    rejectedEpoch = chip.unixtime();
+    rejectedMillis = lastSync;
+    const unsigned long elapsed = lastSync - clockMillis;
+    clockEpoch += elapsed / 1000;
+    clockMillis = lastSync - elapsed % 1000;
     
     #if DEBUG_RTC
       DEBUG_PRINTLN(F("RTC bad"));
     #endif
-    
-    return getFallbackTime();
+    return;
+  }
+  
+  rtcWorking = true;
+  rejectedSet = false;
+  confirmPending = false;
+  
+  // The chip only reports whole seconds: leave the sub-second phase alone
+  // unless the software clock has actually drifted
+  const uint32_t chipEpoch = chip.unixtime();
+  lastDrift = clockSet ? (int16_t)(chipEpoch - softwareEpoch()) : 0;
+  if (!clockSet || lastDrift != 0) {
+    setClock(chipEpoch);
   }
 }
 
+uint32_t RTCManager::getEpoch() {
+  // A failing chip is also only retried once per interval, plus one quick
+  // re-read after a rejection to confirm it (kept short so millis() drift
+  // across power-down stays inside the tolerance)
+  const unsigned long due = confirmPending ? RTC_CONFIRM_DELAY : RTC_RESYNC_INTERVAL;
+  if (rtcInitialized && (resyncRequested || millis() - lastSync >= due)) {
+    syncFromChip();
+  }
+  
+  return softwareEpoch();
+}
+
+DateTime RTCManager::getStableTime() {
+  return DateTime(getEpoch());
+}
+
 DateTime RTCManager::getCurrentTime() {
   if (!rtcInitialized) {
-    return getFallbackTime();
+    return DateTime(softwareEpoch());
   }
   return rtc->now();
 }
 
 bool RTCManager::hasValidTime() const {
-  if (!rtcInitialized) return false;
-  
-  DateTime now = rtc->now();
-  return isValidTime(now);
+  return rtcInitialized && clockSet;
 }
 
 bool RTCManager::setTime(DateTime newTime) {
@@ -161,7 +200,8 @@ bool RTCManager::setTime(DateTime newTime) {
   }
   
   rtc->adjust(newTime);
-  storeGoodTime(newTime);
+  setClock(newTime.unixtime());
+  lastSync = millis();
   rtcWorking = true;
   
   DEBUG_PRINTLN(F("RTC set"));
@@ -180,15 +220,16 @@ bool RTCManager::setAlarm1(const DateTime& alarmTime, bool enableInterrupt) {
     return false;
   }
   
-  // Set Alarm 1 to match hour, minute, and second
-  if (!rtc->setAlarm1(alarmTime, DS3231_A1_Hour)) {
-    DEBUG_PRINTLN_F("A1 fail");
-    return false;
+  // RTClib refuses alarms while INT/SQW is in square-wave mode
+  if (enableInterrupt) {
+    rtc->writeSqwPinMode(DS3231_OFF);
   }
   
-  if (enableInterrupt) {
-    rtc->writeSqwPinMode(DS3231_OFF);  // Disable square wave output
-    // Enable alarm interrupt - this is typically done at the hardware level
+  // Match day of month, hour, minute and second: fires once, not daily
+  rtc->clearAlarm(1);
+  if (!rtc->setAlarm1(alarmTime, DS3231_A1_Date)) {
+    DEBUG_PRINTLN_F("A1 fail");
+    return false;
   }
   
   #if DEBUG_RTC
@@ -290,16 +331,13 @@ void RTCManager::printStatus() const {
   DEBUG_PRINT(rtcInitialized);
   DEBUG_PRINT(" Working: ");
   DEBUG_PRINT(rtcWorking);
-  DEBUG_PRINT(" Last good: ");
-  DEBUG_PRINT(lastGoodYear);
-  DEBUG_PRINT("/");
-  DEBUG_PRINT(lastGoodMonth);
-  DEBUG_PRINT("/");
-  DEBUG_PRINT(lastGoodDay);
-  DEBUG_PRINT(" ");
-  DEBUG_PRINT(lastGoodHour);
-  DEBUG_PRINT(":");
-  DEBUG_PRINTLN(lastGoodMinute);
+  DEBUG_PRINT(" Clock: ");
+  DEBUG_PRINT(softwareEpoch());
+  DEBUG_PRINT(" Last drift: ");
+  DEBUG_PRINT(lastDrift);
+  DEBUG_PRINT("s Synced: ");
+  DEBUG_PRINT(millis() - lastSync);
+  DEBUG_PRINTLN("ms ago");
 }
 
 void RTCManager::printTimeInfo(DateTime dt) const {
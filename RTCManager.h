@@ -14,19 +14,29 @@ private:
   bool rtcInitialized;
   bool rtcWorking;
   
-  // Anti-jump time validation
-  uint16_t lastGoodYear;
-  uint8_t lastGoodMonth;
-  uint8_t lastGoodDay;
-  uint8_t lastGoodHour;
-  uint8_t lastGoodMinute;
-  unsigned long lastRtcRead;
+  // Software clock: epoch seconds at clockMillis, advanced by millis()
+  // and resynced from the chip, so reading the time costs no I2C
+  uint32_t clockEpoch;
+  unsigned long clockMillis;
+  unsigned long lastSync;       // millis() of the last chip read
+  bool clockSet;                // Has had one valid chip read (or setTime)
+  bool resyncRequested;
+  int16_t lastDrift;            // Chip minus software clock at the last resync (s)
+  
+  // Last rejected chip reading, to accept the chip again once two
+  // consecutive reads agree (the software clock drifts while it is bad)
+  uint32_t rejectedEpoch;
+  unsigned long rejectedMillis;
+  bool rejectedSet;
+  bool confirmPending;          // Re-read after RTC_CONFIRM_DELAY, not the full interval
   
   // Internal helper methods
   bool isValidTime(DateTime dt) const;
-  bool isReasonableTimeChange(DateTime newTime) const;
-  void storeGoodTime(DateTime dt);
-  DateTime getFallbackTime() const;
+  bool isReasonableTimeChange(DateTime newTime) const;  // Against the software clock
+  bool confirmsRejectedTime(uint32_t chipEpoch) const;   // Against the last rejected read
+  void setClock(uint32_t epoch);
+  void syncFromChip();
+  uint32_t softwareEpoch() const;
   
 public:
   RTCManager(RTC_DS3231* rtcPtr);
@@ -34,9 +44,11 @@ public:
   // Initialization
   bool begin();
   
-  // Time retrieval
+  // Time retrieval (software clock; reads the chip only when a resync is due)
+  uint32_t getEpoch();        // Unix seconds
   DateTime getStableTime();
-  DateTime getCurrentTime();  // Raw time without validation
+  DateTime getCurrentTime();  // Raw chip time without validation
+  void requestResync() { resyncRequested = true; }  // e.g. after an untimed sleep
   
   // Status
   bool isInitialized() const { return rtcInitialized; }
@@ -48,7 +60,7 @@ public:
   bool setTimeFromCompile();
   
   // Alarm functionality
-  bool setAlarm1(const DateTime& alarmTime, bool enableInterrupt = true);
+  bool setAlarm1(const DateTime& alarmTime, bool enableInterrupt = true);  // Matches date + h:m:s
   bool setAlarm2(const DateTime& alarmTime, bool enableInterrupt = true);
   void clearAlarm1();
   void clearAlarm2();
@@ -0,0 +1,189 @@
+#include "SettingsStore.h"
+#include <stddef.h>
+#include <util/crc16.h>
+
+static const uint8_t SETTINGS_MAGIC = 0x5E;
+static const uint8_t SETTINGS_FLAG_HEATER = 0x01;
+static const uint8_t SETTINGS_FLAG_PI = 0x02;
+
+static_assert(sizeof(SettingsRecord) == SETTINGS_RECORD_SIZE, "settings record size mismatch");
+static_assert(EEPROM_PAGE_SIZE % SETTINGS_RECORD_SIZE == 0, "settings records must not straddle pages");
+static_assert(EEPROM_SETTINGS_BASE + EEPROM_SETTINGS_SIZE <= EEPROM_SIZE, "settings log overflows the EEPROM");
+
+static uint8_t recordCrc(const SettingsRecord& record) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < offsetof(SettingsRecord, crc); i++) {
+    crc = _crc8_ccitt_update(crc, bytes[i]);
+  }
+  return crc;
+}
+
+SettingsStore::SettingsStore(AT24C32* eepromPtr)
+  : eeprom(eepromPtr), head(-1), sequence(0), saved(), writeCount(0), sequenceChecked(false) {
+}
+
+bool SettingsStore::begin() {
+  head = -1;
+  if (!eeprom || !eeprom->isPresent()) {
+    return false;
+  }
+  
+  head = findHeadBySearch();
+  if (head < 0) {
+    uint16_t newestSequence;
+    head = findHeadByScan(newestSequence);
+    sequenceChecked = true;
+  }
+  
+  SettingsRecord record;
+  if (head < 0 || !readRecord(head, record)) {
+    head = -1;
+    DEBUG_PRINTLN_F("Settings: defaults");
+    return false;
+  }
+  
+  sequence = record.sequence;
+  saved.targetTemp = record.targetTemp;
+  saved.heaterEnabled = record.flags & SETTINGS_FLAG_HEATER;
+  saved.piControl = record.flags & SETTINGS_FLAG_PI;
+  
+  #if DEBUG_ENABLED
+    Serial.print(F("Settings @"));
+    Serial.print(head);
+    Serial.print(F(" #"));
+    Serial.println(sequence);
+  #endif
+  return true;
+}
+
+bool SettingsStore::save(const PersistentSettings& settings) {
+  if (!eeprom || !eeprom->isPresent()) {
+    return false;
+  }
+  
+  // Damage the boot search could not see may hide newer records later in
+  // the log. Continue after the highest sequence present, never reusing
+  // one (checked once, on the first save rather than at boot).
+  bool newerFound = false;
+  if (!sequenceChecked) {
+    uint16_t newestSequence;
+    const int16_t newest = findHeadByScan(newestSequence);
+    if (newest >= 0 && (head < 0 || (int16_t)(newestSequence - sequence) > 0)) {
+      head = newest;
+      sequence = newestSequence;
+      newerFound = true;  // What was restored is not the newest record
+    }
+    sequenceChecked = true;
+  }
+  
+  // Unchanged settings cost no write at all
+  if (head >= 0 && !newerFound && settings.targetTemp == saved.targetTemp &&
+      settings.heaterEnabled == saved.heaterEnabled && settings.piControl == saved.piControl) {
+    return true;
+  }
+  
+  SettingsRecord record;
+  memset(&record, 0, sizeof(record));
+  record.magic = SETTINGS_MAGIC;
+  record.flags = (settings.heaterEnabled ? SETTINGS_FLAG_HEATER : 0) |
+                 (settings.piControl ? SETTINGS_FLAG_PI : 0);
+  record.sequence = (head >= 0) ? sequence + 1 : 0;
+  record.targetTemp = settings.targetTemp;
+  record.crc = recordCrc(record);
+  
+  // Overwrites the oldest snapshot; a torn write only loses this record
+  const uint8_t slot = (head + 1) % SLOT_COUNT;
+  if (!eeprom->write(slotAddress(slot), &record, sizeof(record))) {
+    DEBUG_PRINTLN_F("ERR: Settings write");
+    return false;
+  }
+  
+  head = slot;
+  sequence = record.sequence;
+  saved = settings;
+  writeCount++;
+  return true;
+}
+
+uint16_t SettingsStore::slotAddress(uint8_t slot) {
+  return EEPROM_SETTINGS_BASE + (uint16_t)slot * SETTINGS_RECORD_SIZE;
+}
+
+bool SettingsStore::readRecord(uint8_t slot, SettingsRecord& record) const {
+  if (!eeprom->read(slotAddress(slot), &record, sizeof(record))) {
+    return false;
+  }
+  return record.magic == SETTINGS_MAGIC && record.crc == recordCrc(record);
+}
+
+bool SettingsStore::inLap(uint8_t slot, uint16_t firstSequence) const {
+  // Written in the same pass round the ring as slot 0
+  SettingsRecord record;
+  return readRecord(slot, record) && record.sequence == (uint16_t)(firstSequence + slot);
+}
+
+int16_t SettingsStore::findHeadBySearch() const {
+  // Slots 0..head belong to the current lap (sequence = slot 0's + slot);
+  // everything after is older or blank. Binary search for the boundary.
+  SettingsRecord first;
+  if (!readRecord(0, first)) {
+    return -1;
+  }
+  
+  uint8_t lo = 0;             // Known in the current lap
+  uint8_t hi = SLOT_COUNT;    // Known past it
+  while (hi - lo > 1) {
+    const uint8_t mid = lo + (hi - lo) / 2;
+    if (inLap(mid, first.sequence)) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  
+  // Bad records inside the lap would look like the boundary. The real
+  // boundary has no current-lap record in the few slots after it.
+  for (uint8_t probe = lo + 2; probe < SLOT_COUNT && probe <= lo + 1 + SETTINGS_DAMAGE_PROBE; probe++) {
+    if (inLap(probe, first.sequence)) {
+      DEBUG_PRINTLN_F("Settings: log damaged");
+      return -1;
+    }
+  }
+  return lo;
+}
+
+int16_t SettingsStore::findHeadByScan(uint16_t& newestSequence) const {
+  // One bounded pass over the record headers; only a record that would be
+  // the newest so far is read in full for its CRC
+  int16_t newest = -1;
+  newestSequence = 0;
+  SettingsRecord record;
+  
+  for (uint8_t slot = 0; slot < SLOT_COUNT; slot++) {
+    if (!eeprom->read(slotAddress(slot), &record, offsetof(SettingsRecord, targetTemp))) {
+      return -1;
+    }
+    if (record.magic != SETTINGS_MAGIC) continue;
+    
+    // Sequence numbers wrap: compare by signed difference
+    if (newest >= 0 && (int16_t)(record.sequence - newestSequence) <= 0) continue;
+    if (!readRecord(slot, record)) continue;
+    
+    newest = slot;
+    newestSequence = record.sequence;
+  }
+  
+  return newest;
+}
+
+void SettingsStore::printStatus() const {
+  #if DEBUG_ENABLED
+    Serial.print(F("Settings head: "));
+    Serial.print(head);
+    Serial.print(F(" seq: "));
+    Serial.print(sequence);
+    Serial.print(F(" writes: "));
+    Serial.println(writeCount);
+  #endif
+}
@@ -0,0 +1,63 @@
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "AT24C32.h"
+
+// User settings that survive a reset
+struct PersistentSettings {
+  temp_t targetTemp;      // centi-degrees
+  bool heaterEnabled;     // Master enable
+  bool piControl;         // PI rather than ladder control
+};
+
+// One log entry: a full snapshot, so the newest valid record is the
+// whole state and nothing ever has to be merged or copied forward
+struct SettingsRecord {
+  uint8_t magic;          // SETTINGS_MAGIC (doubles as the layout version)
+  uint8_t flags;          // SETTINGS_FLAG_* bits
+  uint16_t sequence;      // +1 per record, wrapping
+  temp_t targetTemp;
+  uint8_t reserved[9];
+  uint8_t crc;            // CRC8 over the bytes before it
+};
+
+// Append-only settings log in the upper half of the AT24C32. Records go
+// round a ring of SETTINGS_RECORD_SIZE slots, so every save lands on the
+// next cells and the oldest snapshot is the one overwritten. Boot finds
+// the newest record by binary search on the sequence numbers (~8 reads),
+// with a bounded linear scan as the fallback when the log looks damaged.
+class SettingsStore {
+private:
+  static const uint8_t SLOT_COUNT = EEPROM_SETTINGS_SIZE / SETTINGS_RECORD_SIZE;
+  
+  AT24C32* eeprom;
+  int16_t head;           // Slot of the newest record, -1 when the log is empty
+  uint16_t sequence;      // Sequence number of the newest record
+  PersistentSettings saved;
+  uint16_t writeCount;    // Records appended since boot
+  bool sequenceChecked;   // Whole log scanned for a newer sequence this boot
+  
+  bool readRecord(uint8_t slot, SettingsRecord& record) const;
+  bool inLap(uint8_t slot, uint16_t firstSequence) const;
+  int16_t findHeadBySearch() const;
+  int16_t findHeadByScan(uint16_t& newestSequence) const;
+  static uint16_t slotAddress(uint8_t slot);
+
+public:
+  SettingsStore(AT24C32* eepromPtr);
+  
+  // Recover the newest record; false if there is none (defaults apply)
+  bool begin();
+  bool hasSettings() const { return head >= 0; }
+  const PersistentSettings& get() const { return saved; }
+  
+  // Append a record unless it matches the newest one
+  bool save(const PersistentSettings& settings);
+  
+  // Debug
+  void printStatus() const;
+};
+
+#endif // SETTINGS_STORE_H
@@ -0,0 +1,110 @@
+#include "TaskScheduler.h"
+
+TaskScheduler::TaskScheduler() : taskCount(0) {
+}
+
+int8_t TaskScheduler::addTask(TaskCallback callback, unsigned long period, unsigned long initialDelay) {
+  if (taskCount >= MAX_SCHEDULED_TASKS || callback == nullptr) {
+    DEBUG_PRINTLN_F("ERR: Task table full");
+    return -1;
+  }
+  
+  ScheduledTask& task = tasks[taskCount];
+  task.callback = callback;
+  task.period = period;
+  task.nextDue = millis() + initialDelay;
+  task.overruns = 0;
+  task.enabled = true;
+  
+  return taskCount++;
+}
+
+void TaskScheduler::setTaskEnabled(uint8_t id, bool enabled) {
+  if (!isValidTask(id)) return;
+  
+  // Re-enabled tasks start a fresh period instead of firing a stale deadline
+  if (enabled && !tasks[id].enabled) {
+    tasks[id].nextDue = millis() + tasks[id].period;
+  }
+  tasks[id].enabled = enabled;
+}
+
+void TaskScheduler::setTaskPeriod(uint8_t id, unsigned long period) {
+  if (!isValidTask(id)) return;
+  tasks[id].period = period;
+}
+
+void TaskScheduler::runTaskSoon(uint8_t id) {
+  if (!isValidTask(id)) return;
+  tasks[id].nextDue = millis();
+}
+
+void TaskScheduler::deferTask(uint8_t id, unsigned long delay) {
+  if (!isValidTask(id)) return;
+  tasks[id].nextDue = millis() + delay;
+}
+
+void TaskScheduler::run() {
+  for (uint8_t i = 0; i < taskCount; i++) {
+    ScheduledTask& task = tasks[i];
+    if (!task.enabled) continue;
+    
+    // Signed difference keeps the comparison correct across millis() rollover
+    const unsigned long now = millis();
+    const long lateness = (long)(now - task.nextDue);
+    if (lateness < 0) continue;
+    
+    if ((unsigned long)lateness >= task.period) {
+      // A whole period was missed: count it and re-phase from now
+      if (task.overruns < 0xFFFF) task.overruns++;
+      task.nextDue = now + task.period;
+    } else {
+      task.nextDue += task.period;
+    }
+    
+    task.callback();
+  }
+}
+
+unsigned long TaskScheduler::getTimeUntilNextDue() const {
+  const unsigned long now = millis();
+  unsigned long earliest = 0xFFFFFFFFUL;
+  
+  for (uint8_t i = 0; i < taskCount; i++) {
+    if (!tasks[i].enabled) continue;
+    
+    const long remaining = (long)(tasks[i].nextDue - now);
+    if (remaining <= 0) return 0;
+    if ((unsigned long)remaining < earliest) {
+      earliest = remaining;
+    }
+  }
+  
+  return earliest;
+}
+
+uint16_t TaskScheduler::getOverrunCount(uint8_t id) const {
+  return isValidTask(id) ? tasks[id].overruns : 0;
+}
+
+void TaskScheduler::resetOverrunCounts() {
+  for (uint8_t i = 0; i < taskCount; i++) {
+    tasks[i].overruns = 0;
+  }
+}
+
+void TaskScheduler::printStatus() const {
+  #if DEBUG_ENABLED
+    const unsigned long now = millis();
+    for (uint8_t i = 0; i < taskCount; i++) {
+      Serial.print(F("Task"));
+      Serial.print(i);
+      Serial.print(F(" P:"));
+      Serial.print(tasks[i].period);
+      Serial.print(F(" Due:"));
+      Serial.print((long)(tasks[i].nextDue - now));
+      Serial.print(F(" Ovr:"));
+      Serial.println(tasks[i].overruns);
+    }
+  #endif
+}
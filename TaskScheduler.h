@@ -0,0 +1,54 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// Periodic tasks are plain static callbacks; instance state is reached
+// through the owner's static instance pointer, as with the menu callbacks
+typedef void (*TaskCallback)();
+
+struct ScheduledTask {
+  TaskCallback callback;
+  unsigned long period;    // ms between runs
+  unsigned long nextDue;   // millis() deadline of the next run
+  uint16_t overruns;       // Runs that started a full period or more late
+  bool enabled;
+};
+
+// Cooperative deadline scheduler with a fixed-capacity task table. Tasks
+// keep a fixed cadence (the deadline advances by one period per run) and
+// skip ahead rather than burst when a deadline was missed entirely.
+class TaskScheduler {
+private:
+  ScheduledTask tasks[MAX_SCHEDULED_TASKS];
+  uint8_t taskCount;
+  
+  bool isValidTask(uint8_t id) const { return id < taskCount; }
+
+public:
+  TaskScheduler();
+  
+  // Task table (ids are handed out in registration order; -1 when full)
+  int8_t addTask(TaskCallback callback, unsigned long period, unsigned long initialDelay = 0);
+  void setTaskEnabled(uint8_t id, bool enabled);
+  void setTaskPeriod(uint8_t id, unsigned long period);
+  void runTaskSoon(uint8_t id);  // Make a task due on the next run()
+  void deferTask(uint8_t id, unsigned long delay);  // Next run no sooner than delay from now
+  
+  // Run every task whose deadline has passed (call every loop)
+  void run();
+  
+  // Time until the earliest enabled deadline (0 if one is already due)
+  unsigned long getTimeUntilNextDue() const;
+  
+  // Status
+  uint8_t getTaskCount() const { return taskCount; }
+  uint16_t getOverrunCount(uint8_t id) const;
+  void resetOverrunCounts();
+  
+  // Debug
+  void printStatus() const;
+};
+
+#endif // TASK_SCHEDULER_H
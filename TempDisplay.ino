@@ -40,11 +40,6 @@ void setup() {
     }
   }
   
-  // Setup rotary encoder interrupt
-  pinMode(ENCODER_CLK_PIN, INPUT);
-  pinMode(ENCODER_DT_PIN, INPUT);
-  attachInterrupt(digitalPinToInterrupt(ENCODER_CLK_PIN), rotaryISR, CHANGE);
-  
   Serial.println("System ready!");
   
   // Optional: Run initial diagnostics
@@ -57,13 +52,6 @@ void loop() {
   // Main system loop - all logic is handled by the controller
   controller.loop();
   
-  // Small delay to prevent excessive CPU usage
-  delay(10);
+  // Sleep until the next scheduled task or input (power-down once parked)
+  controller.idle();
 }
-
-// Interrupt Service Routine for rotary encoder
-void rotaryISR() {
-  if (g_controller) {
-    g_controller->handleRotaryISR();
-  }
-}
\ No newline at end of file
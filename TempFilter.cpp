@@ -0,0 +1,78 @@
+#include "TempFilter.h"
+
+TempFilter::TempFilter()
+  : head(0), count(0), consecutiveRejects(0), totalRejects(0) {
+}
+
+void TempFilter::reset() {
+  head = 0;
+  count = 0;
+  consecutiveRejects = 0;
+}
+
+bool TempFilter::isSpike(temp_t sample) const {
+  if (count == 0) {
+    // The DS18B20 power-on register value is never a valid first reading
+    return sample == TEMP_POWER_ON_VALUE;
+  }
+  
+  return abs(sample - getMedian()) > TEMP_FILTER_SPIKE_LIMIT;
+}
+
+bool TempFilter::addSample(temp_t sample) {
+  if (isSpike(sample)) {
+    totalRejects++;
+    
+    // A run of consistent "spikes" is a real step change: follow it
+    if (++consecutiveRejects < TEMP_FILTER_MAX_REJECTS || count == 0) {
+      #if DEBUG_ENABLED
+        Serial.print(F("TSpike:"));
+        Serial.println(sample);
+      #endif
+      return false;
+    }
+    reset();
+  }
+  
+  consecutiveRejects = 0;
+  
+  if (count == TEMP_FILTER_SIZE) {
+    // Window full: retire the oldest sample from the sorted view
+    removeSorted(window[head]);
+  } else {
+    count++;
+  }
+  
+  window[head] = sample;
+  head = (head + 1) % TEMP_FILTER_SIZE;
+  insertSorted(sample);
+  return true;
+}
+
+void TempFilter::removeSorted(temp_t value) {
+  // Sorted view currently holds count samples, one of them being value
+  uint8_t i = 0;
+  while (i < count && sorted[i] != value) i++;
+  for (; i + 1 < count; i++) {
+    sorted[i] = sorted[i + 1];
+  }
+}
+
+void TempFilter::insertSorted(temp_t value) {
+  // count already includes the new sample; shift larger values up one
+  int8_t i = count - 2;
+  while (i >= 0 && sorted[i] > value) {
+    sorted[i + 1] = sorted[i];
+    i--;
+  }
+  sorted[i + 1] = value;
+}
+
+void TempFilter::printStatus() const {
+  DEBUG_PRINT_F("TempFilter - Count: ");
+  DEBUG_PRINT(count);
+  DEBUG_PRINT_F(" Median: ");
+  DEBUG_PRINT(count ? getMedian() : 0);
+  DEBUG_PRINT_F(" Rejects: ");
+  DEBUG_PRINTLN(totalRejects);
+}
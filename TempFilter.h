@@ -0,0 +1,40 @@
+#ifndef TEMP_FILTER_H
+#define TEMP_FILTER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// Running median over the last TEMP_FILTER_SIZE samples with spike
+// rejection. No heap: a ring buffer in arrival order plus the same
+// samples kept sorted, so each update is a bounded shift of a few bytes.
+class TempFilter {
+private:
+  temp_t window[TEMP_FILTER_SIZE];  // Samples in arrival order (ring)
+  temp_t sorted[TEMP_FILTER_SIZE];  // Same samples, ascending
+  uint8_t head;                     // Next ring slot to overwrite
+  uint8_t count;                    // Valid samples (≤ TEMP_FILTER_SIZE)
+  uint8_t consecutiveRejects;
+  uint16_t totalRejects;
+  
+  // Internal helper methods
+  void removeSorted(temp_t value);
+  void insertSorted(temp_t value);
+  bool isSpike(temp_t sample) const;
+
+public:
+  TempFilter();
+  
+  // Feed a raw sample; returns false if it was rejected as a spike
+  bool addSample(temp_t sample);
+  void reset();
+  
+  // Filtered output
+  bool isReady() const { return count >= TEMP_FILTER_MIN_SAMPLES; }
+  temp_t getMedian() const { return sorted[count / 2]; }
+  uint16_t getRejectCount() const { return totalRejects; }
+  
+  // Debug
+  void printStatus() const;
+};
+
+#endif // TEMP_FILTER_H
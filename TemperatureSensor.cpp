@@ -0,0 +1,225 @@
+#include "TemperatureSensor.h"
+
+// DS18B20 function commands and scratchpad layout
+#define DS18B20_WRITE_SCRATCHPAD 0x4E
+#define SCRATCH_TEMP_LSB 0
+#define SCRATCH_TEMP_MSB 1
+#define SCRATCH_HIGH_ALARM 2
+#define SCRATCH_LOW_ALARM 3
+
+TemperatureSensor::TemperatureSensor(OneWire* oneWirePtr, DallasTemperature* sensorsPtr)
+  : oneWire(oneWirePtr), sensors(sensorsPtr), sensorCount(0), needsEnumeration(true),
+    phase(SENSOR_IDLE), resolution(TEMP_SENSOR_RESOLUTION),
+    requestedResolution(TEMP_SENSOR_RESOLUTION), parasitePower(false),
+    conversionStart(0), conversionTime(0), hasStarted(false),
+    lastTemp(TEMP_C(DEVICE_DISCONNECTED_C)), alarmHigh(0), alarmLow(0),
+    newSample(false), sensorError(false) {
+}
+
+bool TemperatureSensor::begin() {
+  sensors->begin();
+  
+  // Never let requestTemperatures() spin on the bus; update() polls instead
+  sensors->setWaitForConversion(false);
+  parasitePower = sensors->isParasitePowerMode();
+  phase = SENSOR_IDLE;
+  
+  sensorError = (enumerate() == 0);
+  return !sensorError;
+}
+
+uint8_t TemperatureSensor::enumerate() {
+  // Walk the OneWire search once and cache every valid ROM code
+  sensorCount = 0;
+  oneWire->reset_search();
+  
+  while (sensorCount < TEMP_SENSOR_MAX_DEVICES && oneWire->search(addresses[sensorCount])) {
+    const uint8_t* addr = addresses[sensorCount];
+    if (sensors->validAddress(addr) && sensors->validFamily(addr)) {
+      ScratchPad scratch;
+      if (sensors->isConnected(addr, scratch)) {
+        alarmHigh = scratch[SCRATCH_HIGH_ALARM];
+        alarmLow = scratch[SCRATCH_LOW_ALARM];
+      }
+      writeResolution(addr, requestedResolution);
+      sensorCount++;
+    }
+  }
+  
+  resolution = requestedResolution;
+  conversionTime = conversionTimeFor(resolution);
+  needsEnumeration = false;
+  
+  #if DEBUG_ENABLED
+    Serial.print(F("TempEnum:"));
+    Serial.println(sensorCount);
+  #endif
+  
+  return sensorCount;
+}
+
+bool TemperatureSensor::isSensorPresent() {
+  // A bus reset with presence pulse is far cheaper than a full search
+  return oneWire->reset() != 0;
+}
+
+void TemperatureSensor::writeResolution(const uint8_t* addr, uint8_t bits) {
+  // Write the configuration register straight into the scratchpad. Unlike
+  // DallasTemperature::setResolution() this never copies to the sensor's
+  // EEPROM, so switching resolution costs no wear and no 20 ms delay.
+  oneWire->reset();
+  oneWire->select(addr);
+  oneWire->write(DS18B20_WRITE_SCRATCHPAD);
+  oneWire->write(alarmHigh);
+  oneWire->write(alarmLow);
+  oneWire->write(((bits - 9) << 5) | 0x1F);
+  oneWire->reset();
+}
+
+void TemperatureSensor::setResolution(uint8_t bits) {
+  requestedResolution = constrain(bits, 9, 12);
+}
+
+unsigned long TemperatureSensor::conversionTimeFor(uint8_t bits) {
+  // 750 ms at 12 bits, halved for every bit less (94 ms at 9 bits)
+  return 750UL >> (12 - bits);
+}
+
+void TemperatureSensor::update() {
+  const unsigned long now = millis();
+  
+  if (phase == SENSOR_CONVERTING) {
+    if (isConversionDone(now)) {
+      collectResult();
+    }
+    return;
+  }
+  
+  // Start the next conversion once the sample interval has elapsed
+  if (hasStarted && now - conversionStart < TEMP_SAMPLE_INTERVAL) {
+    return;
+  }
+  
+  if (sensorCount == 0) {
+    // Nothing cached: only search again once something answers the bus
+    conversionStart = now;
+    hasStarted = true;
+    if (!isSensorPresent()) return;
+    needsEnumeration = true;
+  }
+  
+  if (needsEnumeration && enumerate() == 0) {
+    sensorError = true;
+    return;
+  }
+  
+  // Switch bit depth only between conversions (cabin sensor only; the
+  // TH/TL bytes written back are the ones read with its last sample)
+  if (requestedResolution != resolution) {
+    writeResolution(addresses[0], requestedResolution);
+    resolution = requestedResolution;
+    conversionTime = conversionTimeFor(resolution);
+  }
+  
+  startConversion(now);
+}
+
+unsigned long TemperatureSensor::getTimeUntilNextConversion() const {
+  if (phase == SENSOR_CONVERTING || !hasStarted) return 0;
+  
+  const unsigned long elapsed = millis() - conversionStart;
+  return (elapsed < TEMP_SAMPLE_INTERVAL) ? TEMP_SAMPLE_INTERVAL - elapsed : 0;
+}
+
+void TemperatureSensor::startConversion(unsigned long now) {
+  sensors->requestTemperatures();  // Returns immediately (async mode)
+  conversionStart = now;
+  hasStarted = true;
+  phase = SENSOR_CONVERTING;
+}
+
+bool TemperatureSensor::isConversionDone(unsigned long now) {
+  // Worst-case conversion time always ends the wait
+  if (now - conversionStart >= conversionTime) return true;
+  
+  // With external power the sensor holds the bus low until it is done, so a
+  // single read slot tells us if we can collect early. In parasite mode the
+  // bus is held high by the strong pull-up and must not be polled.
+  if (!parasitePower) {
+    return sensors->isConversionComplete();
+  }
+  return false;
+}
+
+void TemperatureSensor::collectResult() {
+  phase = SENSOR_IDLE;
+  
+  // Read the cabin sensor by its cached ROM code; isConnected() reads the
+  // scratchpad and fails on a missing sensor or a CRC mismatch
+  ScratchPad scratch;
+  if (!sensors->isConnected(addresses[0], scratch)) {
+    // CRC failure or sensor gone: re-enumerate before the next conversion
+    needsEnumeration = true;
+    sensorError = true;
+    return;
+  }
+  
+  alarmHigh = scratch[SCRATCH_HIGH_ALARM];
+  alarmLow = scratch[SCRATCH_LOW_ALARM];
+  
+  int16_t raw = (int16_t)(((uint16_t)scratch[SCRATCH_TEMP_MSB] << 8) | scratch[SCRATCH_TEMP_LSB]);
+  temp_t temp = rawToCenti(raw, resolution);
+  
+  if (temp > TEMP_C(-50) && temp < TEMP_C(100)) {
+    lastTemp = temp;
+    newSample = true;
+    sensorError = false;
+  } else {
+    sensorError = true;
+  }
+}
+
+bool TemperatureSensor::hasNewSample() {
+  if (!newSample) return false;
+  newSample = false;
+  return true;
+}
+
+const uint8_t* TemperatureSensor::getAddress(uint8_t index) const {
+  if (index >= sensorCount) return nullptr;
+  return addresses[index];
+}
+
+temp_t TemperatureSensor::rawToCenti(int16_t raw, uint8_t bits) {
+  // Raw register is 1/16 °C; the low bits are undefined below 12 bits
+  raw &= ~((1 << (12 - bits)) - 1);
+  
+  // centi = raw * 100 / 16, rounded
+  return (temp_t)(((int32_t)raw * 25 + 2) >> 2);
+}
+
+bool TemperatureSensor::readBlocking() {
+  if (sensorCount == 0) return false;
+  
+  sensors->requestTemperatures();
+  delay(conversionTime);
+  
+  // Any in-flight async conversion was superseded
+  phase = SENSOR_IDLE;
+  
+  ScratchPad scratch;
+  return sensors->isConnected(addresses[0], scratch);
+}
+
+void TemperatureSensor::printStatus() const {
+  DEBUG_PRINT_F("TempSensor - Phase: ");
+  DEBUG_PRINT(phase);
+  DEBUG_PRINT_F(" Count: ");
+  DEBUG_PRINT(sensorCount);
+  DEBUG_PRINT_F(" Res: ");
+  DEBUG_PRINT(resolution);
+  DEBUG_PRINT_F(" Last: ");
+  DEBUG_PRINT(lastTemp);
+  DEBUG_PRINT_F(" Err: ");
+  DEBUG_PRINTLN(sensorError);
+}
@@ -0,0 +1,82 @@
+#ifndef TEMPERATURE_SENSOR_H
+#define TEMPERATURE_SENSOR_H
+
+#include <Arduino.h>
+#include <OneWire.h>
+#include <DallasTemperature.h>
+#include "Config.h"
+
+// Split-phase acquisition: a conversion is started, the main loop keeps
+// running, and the result is collected once the conversion has finished.
+enum SensorPhase {
+  SENSOR_IDLE,        // No conversion in flight
+  SENSOR_CONVERTING   // Conversion started, waiting for result
+};
+
+class TemperatureSensor {
+private:
+  // Hardware
+  OneWire* oneWire;
+  DallasTemperature* sensors;
+  
+  // Sensor registry: ROM codes cached at enumeration, reads go by address
+  DeviceAddress addresses[TEMP_SENSOR_MAX_DEVICES];
+  uint8_t sensorCount;
+  bool needsEnumeration;
+  
+  // Acquisition state
+  SensorPhase phase;
+  uint8_t resolution;           // Bit depth programmed into the sensor
+  uint8_t requestedResolution;  // Applied before the next conversion
+  bool parasitePower;
+  unsigned long conversionStart;
+  unsigned long conversionTime;  // Worst-case conversion time for resolution
+  bool hasStarted;
+  
+  // Last result
+  temp_t lastTemp;  // centi-degrees
+  uint8_t alarmHigh;  // TH/TL scratchpad bytes, preserved on config writes
+  uint8_t alarmLow;
+  bool newSample;
+  bool sensorError;
+  
+  // Internal helper methods
+  uint8_t enumerate();
+  bool isSensorPresent();
+  void writeResolution(const uint8_t* addr, uint8_t bits);
+  void startConversion(unsigned long now);
+  bool isConversionDone(unsigned long now);
+  void collectResult();
+  static temp_t rawToCenti(int16_t raw, uint8_t bits);
+  static unsigned long conversionTimeFor(uint8_t bits);
+
+public:
+  TemperatureSensor(OneWire* oneWirePtr, DallasTemperature* sensorsPtr);
+  
+  // Initialization
+  bool begin();
+  
+  // Main update method (call every loop, never blocks on a conversion)
+  void update();
+  
+  // Resolution (9-12 bits); takes effect at the next conversion
+  void setResolution(uint8_t bits);
+  uint8_t getResolution() const { return resolution; }
+  
+  // Results
+  bool hasNewSample();  // True once per collected sample
+  temp_t getTemperature() const { return lastTemp; }
+  bool hasError() const { return sensorError; }
+  bool isConverting() const { return phase == SENSOR_CONVERTING; }
+  unsigned long getTimeUntilNextConversion() const;  // 0 while converting or due
+  uint8_t getDeviceCount() const { return sensorCount; }
+  const uint8_t* getAddress(uint8_t index) const;
+  
+  // Blocking read for diagnostics only
+  bool readBlocking();
+  
+  // Debug
+  void printStatus() const;
+};
+
+#endif // TEMPERATURE_SENSOR_H
@@ -1,19 +1,39 @@
 #include "WakeupTimer.h"
-#include <limits.h>
-
-WakeupTimer::WakeupTimer(RTCManager* rtcMgr) 
-  : rtcManager(rtcMgr), timerCount(0), activeTimerIndex(-1), lastUpdateTime(0),
-    alarm1InUse(false), alarm2InUse(false), alarm1TimerIndex(-1), alarm2TimerIndex(-1) {
-  // Initialize all timers as disabled
-  for (uint8_t i = 0; i < MAX_WAKEUP_TIMERS; i++) {
-    timers[i].enabled = false;
-    timers[i].hour = 7;  // Default 7:00 AM
-    timers[i].minute = 0;
-    timers[i].targetTemp = 20;  // Default 20°C
-    timers[i].dayMask = 0x3E;   // Monday-Friday (bits 1-5)
-    timers[i].state = WAKEUP_DISABLED;
-    strcpy(timers[i].name, "Timer");
+#include "Format.h"
+#include <stddef.h>
+#include <util/crc16.h>
+
+static const uint32_t DAY_SECONDS = 86400UL;
+static const uint8_t WAKEUP_SLOT_USED = 0xA5;      // Erased EEPROM reads 0xFF
+static const uint8_t WAKEUP_INDEX_ENABLED = 0x80;  // Index dayMask flag
+
+static_assert(sizeof(StoredWakeupTimer) <= AT24C32::MAX_WRITE_CHUNK, "timer record must be one write");
+static_assert(sizeof(StoredWakeupTimer) <= EEPROM_PAGE_SIZE, "timer record must fit one page");
+static_assert(MAX_WAKEUP_TIMERS * EEPROM_PAGE_SIZE <= EEPROM_TIMER_SIZE, "timer table overflows its region");
+
+static uint8_t recordCrc(const StoredWakeupTimer& record) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < offsetof(StoredWakeupTimer, crc); i++) {
+    crc = _crc8_ccitt_update(crc, bytes[i]);
   }
+  return crc;
+}
+
+static WakeupIndexEntry indexEntryFor(const StoredWakeupTimer& record, uint8_t slot) {
+  WakeupIndexEntry entry;
+  entry.minuteOfDay = record.hour * 60 + record.minute;
+  entry.dayMask = (record.dayMask & 0x7F) | (record.enabled ? WAKEUP_INDEX_ENABLED : 0);
+  entry.slot = slot;
+  return entry;
+}
+
+WakeupTimer::WakeupTimer(RTCManager* rtcMgr, AT24C32* eepromPtr) 
+  : rtcManager(rtcMgr), eeprom(eepromPtr), timerCount(0), upcomingCount(0),
+    nextDeadline(NO_DEADLINE), activeUpcoming(-1), viewTimer(),
+    lastUpdateTime(0), lastAlarmPoll(0), checkPending(true),
+    alarm1InUse(false), alarm2InUse(false), alarm1TimerIndex(-1), alarm2TimerIndex(-1),
+    alarm1Time(0) {
 }
 
 bool WakeupTimer::begin() {
@@ -22,31 +42,78 @@ bool WakeupTimer::begin() {
     return false;
   }
   
-  DEBUG_PRINTLN_F("WakeupTimer OK");
+  if (!eeprom || !eeprom->isPresent()) {
+    DEBUG_PRINTLN_F("ERR: No timer store");
+    return false;
+  }
+  
+  loadTable();
+  
+  #if DEBUG_ENABLED
+    Serial.print(F("WakeupTimer OK: "));
+    Serial.println(timerCount);
+  #endif
   return true;
 }
 
-void WakeupTimer::update(float currentTemp) {
-  const unsigned long now = millis();
-  if (now - lastUpdateTime < 5000) {  // Update every 5 seconds
-    return;
+void WakeupTimer::update(temp_t currentTemp) {
+  const unsigned long ms = millis();
+  
+  // Between timers the DS3231 alarm says when to look again. The A1 flag
+  // is still read now and then in case the INT line is not wired.
+  if (!checkPending && alarm1InUse && ms - lastAlarmPoll >= WAKEUP_ALARM_POLL_INTERVAL) {
+    lastAlarmPoll = ms;
+    if (rtcManager->isAlarm1Triggered()) {
+      handleAlarmInterrupt(1);
+    }
   }
-  lastUpdateTime = now;
   
   if (!rtcManager->hasValidTime()) {
     return;  // Can't update timers without valid time
   }
+  const uint32_t now = rtcManager->getEpoch();
+  
+  // Nothing can change before the earliest deadline, except the cabin
+  // reaching temperature while a timer is heating
+  const bool heating = activeUpcoming >= 0 && ms - lastUpdateTime >= WAKEUP_ACTIVE_INTERVAL;
+  if (!checkPending && now < nextDeadline && !heating) {
+    return;
+  }
+  lastUpdateTime = ms;
   
-  DateTime currentTime = rtcManager->getStableTime();
+  // Timers changed or an alarm fired: refill the upcoming occurrences
+  if (checkPending) {
+    checkPending = false;
+    rebuildSchedule(now);
+  }
   
   // Update all timer states
-  updateTimerStates(currentTime, currentTemp);
+  updateTimerStates(now, currentTemp);
+  
+  // Finished occurrences make room for the next ones
+  if (removeExpiredTimers()) {
+    rebuildSchedule(now);
+    updateTimerStates(now, currentTemp);
+  }
   
   // Check for new active timer
-  checkForNewActiveTimer(currentTime);
+  checkForNewActiveTimer();
+  
+  updateNextDeadline();
+  
+  // Arm Alarm 1 for the next preheat start (no I2C if it is unchanged)
+  scheduleNextAlarm();
+}
+
+void WakeupTimer::handleAlarmInterrupt(uint8_t alarmNumber) {
+  // One-shot alarm: force a rewrite, which also clears the flag and
+  // releases the INT line
+  if (alarmNumber == 1) {
+    alarm1Time = 0;
+  }
+  checkPending = true;
   
-  // Reset expired timers for next day
-  resetExpiredTimers(currentTime);
+  DEBUG_PRINTLN_F("A1 fired");
 }
 
 bool WakeupTimer::addTimer(uint8_t hour, uint8_t minute, uint8_t targetTemp, uint8_t dayMask, const char* name) {
@@ -61,48 +128,49 @@ bool WakeupTimer::addTimer(uint8_t hour, uint8_t minute, uint8_t targetTemp, uin
   }
   
   // Find first available slot
-  for (uint8_t i = 0; i < MAX_WAKEUP_TIMERS; i++) {
-    if (!timers[i].enabled) {
-      timers[i].enabled = true;
-      timers[i].hour = hour;
-      timers[i].minute = minute;
-      timers[i].targetTemp = targetTemp;
-      timers[i].dayMask = dayMask;
-      timers[i].state = WAKEUP_ARMED;
-      
-      // Set name
-      if (name && strlen(name) > 0) {
-        strncpy(timers[i].name, name, 15);
-        timers[i].name[15] = '\0';
-      } else {
-        snprintf(timers[i].name, sizeof(timers[i].name), "Timer %d", i + 1);
-      }
-      
-      timerCount++;
-      #if DEBUG_ENABLED
-        Serial.print(F("T+:"));
-        Serial.println(timers[i].name);
-      #endif
-      return true;
-    }
+  const int8_t slot = findFreeSlot();
+  if (slot < 0) {
+    return false;
+  }
+  
+  StoredWakeupTimer record;
+  memset(&record, 0, sizeof(record));
+  record.hour = hour;
+  record.minute = minute;
+  record.targetTemp = targetTemp;
+  record.dayMask = dayMask & 0x7F;
+  record.enabled = 1;
+  
+  // Set name
+  if (name && strlen(name) > 0) {
+    strncpy(record.name, name, 15);
+    record.name[15] = '\0';
+  } else {
+    Format::number(Format::text(record.name, "Timer "), slot + 1);
   }
   
-  return false;
+  if (!writeRecord(slot, record)) {
+    DEBUG_PRINTLN_F("ERR: Timer write");
+    return false;
+  }
+  
+  insertIndexEntry(indexEntryFor(record, slot));
+  checkPending = true;
+  #if DEBUG_ENABLED
+    Serial.print(F("T+:"));
+    Serial.println(record.name);
+  #endif
+  return true;
 }
 
 bool WakeupTimer::removeTimer(uint8_t index) {
-  if (!isValidTimerIndex(index) || !timers[index].enabled) {
+  if (!isValidTimerIndex(index) || !freeSlot(sortedTimers[index].slot)) {
     return false;
   }
   
-  timers[index].enabled = false;
-  timers[index].state = WAKEUP_DISABLED;
-  
-  if (activeTimerIndex == index) {
-    activeTimerIndex = -1;  // Clear active timer
-  }
-  
-  timerCount--;
+  // The rebuild drops it from the upcoming list (and stops it heating)
+  removeIndexEntry(index);
+  checkPending = true;
   #if DEBUG_ENABLED
     Serial.print(F("T-:"));
     Serial.println(index);
@@ -115,153 +183,143 @@ bool WakeupTimer::enableTimer(uint8_t index, bool enabled) {
     return false;
   }
   
-  if (timers[index].enabled != enabled) {
-    timers[index].enabled = enabled;
-    timers[index].state = enabled ? WAKEUP_ARMED : WAKEUP_DISABLED;
-    
-    if (!enabled && activeTimerIndex == index) {
-      activeTimerIndex = -1;  // Clear active timer
-    }
-    
-    if (enabled) {
-      timerCount++;
-    } else {
-      timerCount--;
-    }
+  if (((sortedTimers[index].dayMask & WAKEUP_INDEX_ENABLED) != 0) == enabled) {
+    return true;
   }
   
-  return true;
+  StoredWakeupTimer record;
+  if (!readRecord(sortedTimers[index].slot, record)) {
+    return false;
+  }
+  record.enabled = enabled;
+  return updateRecord(index, record);
 }
 
 void WakeupTimer::clearAllTimers() {
-  for (uint8_t i = 0; i < MAX_WAKEUP_TIMERS; i++) {
-    timers[i].enabled = false;
-    timers[i].state = WAKEUP_DISABLED;
+  for (uint8_t i = 0; i < timerCount; i++) {
+    freeSlot(sortedTimers[i].slot);
   }
   timerCount = 0;
-  activeTimerIndex = -1;
+  upcomingCount = 0;
+  activeUpcoming = -1;
+  checkPending = true;
   DEBUG_PRINTLN_F("Timers cleared");
 }
 
 bool WakeupTimer::setTimerTime(uint8_t index, uint8_t hour, uint8_t minute) {
-  if (!isValidTimerIndex(index) || !isValidTime(hour, minute)) {
+  StoredWakeupTimer record;
+  if (!isValidTimerIndex(index) || !isValidTime(hour, minute) ||
+      !readRecord(sortedTimers[index].slot, record)) {
     return false;
   }
   
-  timers[index].hour = hour;
-  timers[index].minute = minute;
-  return true;
+  record.hour = hour;
+  record.minute = minute;
+  return updateRecord(index, record);
 }
 
 bool WakeupTimer::setTimerTemp(uint8_t index, uint8_t targetTemp) {
-  if (!isValidTimerIndex(index) || !isValidTemp(targetTemp)) {
+  StoredWakeupTimer record;
+  if (!isValidTimerIndex(index) || !isValidTemp(targetTemp) ||
+      !readRecord(sortedTimers[index].slot, record)) {
     return false;
   }
   
-  timers[index].targetTemp = targetTemp;
-  return true;
+  // A timer that is already heating follows the new target straight away
+  const int8_t u = findUpcoming(sortedTimers[index].slot);
+  if (u >= 0) {
+    upcoming[u].targetTemp = targetTemp;
+  }
+  
+  record.targetTemp = targetTemp;
+  return updateRecord(index, record);
 }
 
 bool WakeupTimer::setTimerDays(uint8_t index, uint8_t dayMask) {
-  if (!isValidTimerIndex(index)) {
+  StoredWakeupTimer record;
+  if (!isValidTimerIndex(index) || !readRecord(sortedTimers[index].slot, record)) {
     return false;
   }
   
-  timers[index].dayMask = dayMask;
-  return true;
+  record.dayMask = dayMask & 0x7F;
+  return updateRecord(index, record);
 }
 
 bool WakeupTimer::setTimerName(uint8_t index, const char* name) {
-  if (!isValidTimerIndex(index) || !name) {
+  StoredWakeupTimer record;
+  if (!isValidTimerIndex(index) || !name || !readRecord(sortedTimers[index].slot, record)) {
     return false;
   }
   
-  strncpy(timers[index].name, name, 15);
-  timers[index].name[15] = '\0';
-  return true;
+  strncpy(record.name, name, 15);
+  record.name[15] = '\0';
+  return updateRecord(index, record);
 }
 
 WakeupTimerData* WakeupTimer::getTimer(uint8_t index) {
-  if (!isValidTimerIndex(index)) {
+  StoredWakeupTimer record;
+  if (!isValidTimerIndex(index) || !readRecord(sortedTimers[index].slot, record)) {
     return nullptr;
   }
-  return &timers[index];
+  
+  viewTimer.enabled = record.enabled;
+  viewTimer.hour = record.hour;
+  viewTimer.minute = record.minute;
+  viewTimer.targetTemp = record.targetTemp;
+  viewTimer.dayMask = record.dayMask;
+  memcpy(viewTimer.name, record.name, sizeof(viewTimer.name));
+  viewTimer.name[15] = '\0';
+  
+  const int8_t u = findUpcoming(sortedTimers[index].slot);
+  if (u >= 0) {
+    viewTimer.state = static_cast<WakeupState>(upcoming[u].state);
+  } else {
+    viewTimer.state = record.enabled ? WAKEUP_ARMED : WAKEUP_DISABLED;
+  }
+  return &viewTimer;
 }
 
 int8_t WakeupTimer::getActiveTimerIndex() const {
-  return activeTimerIndex;
+  if (activeUpcoming < 0) {
+    return -1;
+  }
+  return indexOfSlot(upcoming[activeUpcoming].slot);
 }
 
 WakeupState WakeupTimer::getActiveState() const {
-  if (activeTimerIndex >= 0 && activeTimerIndex < MAX_WAKEUP_TIMERS) {
-    return timers[activeTimerIndex].state;
+  if (activeUpcoming >= 0) {
+    return static_cast<WakeupState>(upcoming[activeUpcoming].state);
   }
   return WAKEUP_DISABLED;
 }
 
 bool WakeupTimer::shouldHeat() const {
-  if (activeTimerIndex < 0) {
+  if (activeUpcoming < 0) {
     return false;
   }
   
-  WakeupState state = timers[activeTimerIndex].state;
+  const uint8_t state = upcoming[activeUpcoming].state;
   return (state == WAKEUP_PREHEATING || state == WAKEUP_READY);
 }
 
 uint8_t WakeupTimer::getActiveTargetTemp() const {
-  if (activeTimerIndex >= 0 && activeTimerIndex < MAX_WAKEUP_TIMERS) {
-    return timers[activeTimerIndex].targetTemp;
+  if (activeUpcoming >= 0) {
+    return upcoming[activeUpcoming].targetTemp;
   }
   return 20;  // Default fallback
 }
 
-bool WakeupTimer::isTimeToStart(const WakeupTimerData& timer, const DateTime& now) const {
-  if (!timer.enabled || !isTimerDayActive(timer, now)) {
-    return false;
-  }
-  
-  // Calculate start time (preheat time before target)
-  DateTime startTime = calculateStartTime(timer, now);
-  
-  // Check if current time is at or after start time but before target time
-  return (now.hour() > startTime.hour() || 
-          (now.hour() == startTime.hour() && now.minute() >= startTime.minute())) &&
-         (now.hour() < timer.hour || 
-          (now.hour() == timer.hour && now.minute() < timer.minute));
-}
-
-bool WakeupTimer::isTimeToStop(const WakeupTimerData& timer, const DateTime& now) const {
-  // Stop 1 hour after target time
-  uint8_t stopHour = timer.hour + 1;
-  if (stopHour >= 24) stopHour = 0;
-  
-  return (now.hour() > stopHour || 
-          (now.hour() == stopHour && now.minute() >= timer.minute));
-}
-
 unsigned long WakeupTimer::getMinutesUntilNextTimer() const {
-  if (timerCount == 0 || !rtcManager->hasValidTime()) {
+  if (upcomingCount == 0 || !rtcManager->hasValidTime()) {
     return 0;
   }
   
-  DateTime now = rtcManager->getStableTime();
-  unsigned long minMinutes = 0xFFFFFFFF;  // Maximum unsigned long value
+  // upcoming[] is in start order
+  const uint32_t now = rtcManager->getEpoch();
+  const uint32_t earliest = upcoming[0].start;
   
-  for (uint8_t i = 0; i < MAX_WAKEUP_TIMERS; i++) {
-    if (!timers[i].enabled) continue;
-    
-    // Calculate next occurrence of this timer
-    DateTime nextTime = calculateStartTime(timers[i], now);
-    
-    // Calculate minutes until next occurrence
-    unsigned long minutes = (nextTime.unixtime() - now.unixtime()) / 60;
-    
-    if (minutes < minMinutes) {
-      minMinutes = minutes;
-    }
-  }
-  
-  return (minMinutes == 0xFFFFFFFF) ? 0 : minMinutes;
+  // Already started reads as zero, never negative
+  return (earliest <= now) ? 0 : (earliest - now) / 60;
 }
 
 // Static utility methods
@@ -281,118 +339,369 @@ WakeupDay WakeupTimer::getCurrentDay(const DateTime& dt) {
   return static_cast<WakeupDay>(dt.dayOfTheWeek());
 }
 
-// Private methods
-void WakeupTimer::updateTimerStates(const DateTime& now, float currentTemp) {
-  for (uint8_t i = 0; i < MAX_WAKEUP_TIMERS; i++) {
-    if (!timers[i].enabled) continue;
+// EEPROM table
+uint16_t WakeupTimer::slotAddress(uint8_t slot) {
+  return EEPROM_TIMER_BASE + (uint16_t)slot * EEPROM_PAGE_SIZE;
+}
+
+bool WakeupTimer::loadTable() {
+  // One bounded pass over the slots; free ones cost a single byte read
+  timerCount = 0;
+  StoredWakeupTimer record;
+  
+  for (uint8_t slot = 0; slot < MAX_WAKEUP_TIMERS; slot++) {
+    uint8_t marker;
+    if (!eeprom->read(slotAddress(slot), &marker, 1)) {
+      return false;
+    }
+    if (marker != WAKEUP_SLOT_USED || !readRecord(slot, record)) continue;
+    
+    insertIndexEntry(indexEntryFor(record, slot));
+  }
+  
+  upcomingCount = 0;
+  activeUpcoming = -1;
+  checkPending = true;
+  return true;
+}
+
+bool WakeupTimer::readRecord(uint8_t slot, StoredWakeupTimer& record) const {
+  if (!eeprom->read(slotAddress(slot), &record, sizeof(record))) {
+    return false;
+  }
+  
+  // Torn or foreign pages are treated as free
+  return record.marker == WAKEUP_SLOT_USED && record.crc == recordCrc(record) &&
+         isValidTime(record.hour, record.minute);
+}
+
+bool WakeupTimer::writeRecord(uint8_t slot, StoredWakeupTimer& record) {
+  record.marker = WAKEUP_SLOT_USED;
+  record.crc = recordCrc(record);
+  return eeprom->write(slotAddress(slot), &record, sizeof(record));
+}
+
+bool WakeupTimer::freeSlot(uint8_t slot) {
+  const uint8_t marker = 0;
+  return eeprom->write(slotAddress(slot), &marker, 1);
+}
+
+int8_t WakeupTimer::findFreeSlot() const {
+  for (uint8_t slot = 0; slot < MAX_WAKEUP_TIMERS; slot++) {
+    if (indexOfSlot(slot) < 0) {
+      return slot;
+    }
+  }
+  return -1;
+}
+
+// Index maintenance
+void WakeupTimer::insertIndexEntry(const WakeupIndexEntry& entry) {
+  // Insertion sort step: shift later times up one place
+  uint8_t pos = timerCount;
+  while (pos > 0 && sortedTimers[pos - 1].minuteOfDay > entry.minuteOfDay) {
+    sortedTimers[pos] = sortedTimers[pos - 1];
+    pos--;
+  }
+  sortedTimers[pos] = entry;
+  timerCount++;
+}
+
+void WakeupTimer::removeIndexEntry(uint8_t index) {
+  for (uint8_t i = index; i + 1 < timerCount; i++) {
+    sortedTimers[i] = sortedTimers[i + 1];
+  }
+  timerCount--;
+}
+
+int8_t WakeupTimer::indexOfSlot(uint8_t slot) const {
+  for (uint8_t i = 0; i < timerCount; i++) {
+    if (sortedTimers[i].slot == slot) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool WakeupTimer::updateRecord(uint8_t index, StoredWakeupTimer& record) {
+  const uint8_t slot = sortedTimers[index].slot;
+  if (!writeRecord(slot, record)) {
+    DEBUG_PRINTLN_F("ERR: Timer write");
+    return false;
+  }
+  
+  // Re-insert: the time of day (sort key) may have changed
+  removeIndexEntry(index);
+  insertIndexEntry(indexEntryFor(record, slot));
+  checkPending = true;
+  return true;
+}
+
+// Schedule
+WakeupDay WakeupTimer::epochDay(uint32_t epoch) {
+  // 1 January 1970 was a Thursday
+  return static_cast<WakeupDay>((epoch / DAY_SECONDS + DAY_THURSDAY) % 7);
+}
+
+bool WakeupTimer::nextOccurrence(const WakeupIndexEntry& entry, uint32_t now,
+                                 uint32_t& start, uint32_t& stop) const {
+  // The day mask selects the day of the target time, so a 00:15 timer
+  // on Monday preheats from 23:45 on Sunday
+  const uint32_t yesterday = now - now % DAY_SECONDS - DAY_SECONDS;
+  
+  // First selected day whose heating window has not ended yet (it may
+  // already be running). The scan starts a day back: a late timer's hold
+  // runs past midnight, and that window is still yesterday's occurrence.
+  for (uint8_t d = 0; d <= 8; d++) {
+    const uint32_t day = yesterday + d * DAY_SECONDS;
+    if (!isDayEnabled(entry.dayMask, epochDay(day))) continue;
     
-    switch (timers[i].state) {
+    const uint32_t target = day + entry.minuteOfDay * 60UL;
+    if (target + WAKEUP_HOLD_MINUTES * 60UL <= now) continue;
+    
+    start = target - WAKEUP_PREHEAT_MINUTES * 60UL;
+    stop = target + WAKEUP_HOLD_MINUTES * 60UL;
+    return true;
+  }
+  
+  return false;  // No days selected
+}
+
+void WakeupTimer::rebuildSchedule(uint32_t now) {
+  // Keep occurrences that are already heating, as long as their timer is
+  // still there, enabled and unchanged
+  uint8_t kept = 0;
+  for (uint8_t u = 0; u < upcomingCount; u++) {
+    const bool running = (upcoming[u].state == WAKEUP_PREHEATING || upcoming[u].state == WAKEUP_READY);
+    const int8_t i = indexOfSlot(upcoming[u].slot);
+    uint32_t start, stop;
+    
+    if (running && i >= 0 && (sortedTimers[i].dayMask & WAKEUP_INDEX_ENABLED) &&
+        nextOccurrence(sortedTimers[i], now, start, stop) && start == upcoming[u].start) {
+      upcoming[kept++] = upcoming[u];
+    }
+  }
+  upcomingCount = kept;
+  activeUpcoming = -1;
+  
+  // Fill the rest in start order: walk the days, and each day's timers in
+  // index (time) order, stopping as soon as the cache is full. Yesterday
+  // comes first, for windows still running past midnight. Only the
+  // target temperature of each new entry is read from the EEPROM.
+  const uint32_t yesterday = now - now % DAY_SECONDS - DAY_SECONDS;
+  for (uint8_t d = 0; d <= 8 && upcomingCount < WAKEUP_CACHE_SIZE; d++) {
+    const uint32_t day = yesterday + d * DAY_SECONDS;
+    const WakeupDay weekday = epochDay(day);
+    
+    for (uint8_t i = 0; i < timerCount && upcomingCount < WAKEUP_CACHE_SIZE; i++) {
+      const WakeupIndexEntry& entry = sortedTimers[i];
+      if (!(entry.dayMask & WAKEUP_INDEX_ENABLED) || !isDayEnabled(entry.dayMask, weekday)) continue;
+      
+      const uint32_t target = day + entry.minuteOfDay * 60UL;
+      if (target + WAKEUP_HOLD_MINUTES * 60UL <= now) continue;  // Window already over
+      if (findUpcoming(entry.slot) >= 0) continue;               // Earlier occurrence cached
+      
+      uint8_t targetTemp;
+      if (!eeprom->read(slotAddress(entry.slot) + offsetof(StoredWakeupTimer, targetTemp),
+                        &targetTemp, 1)) continue;
+      
+      UpcomingWakeup& next = upcoming[upcomingCount++];
+      next.start = target - WAKEUP_PREHEAT_MINUTES * 60UL;
+      next.stop = target + WAKEUP_HOLD_MINUTES * 60UL;
+      next.slot = entry.slot;
+      next.targetTemp = targetTemp;
+      next.state = WAKEUP_ARMED;
+    }
+  }
+}
+
+void WakeupTimer::updateNextDeadline() {
+  // Armed timers wait for their start, heating ones for their stop
+  nextDeadline = NO_DEADLINE;
+  for (uint8_t u = 0; u < upcomingCount; u++) {
+    const uint32_t deadline = (upcoming[u].state == WAKEUP_ARMED) ? upcoming[u].start : upcoming[u].stop;
+    if (deadline < nextDeadline) {
+      nextDeadline = deadline;
+    }
+  }
+}
+
+void WakeupTimer::updateTimerStates(uint32_t now, temp_t currentTemp) {
+  for (uint8_t u = 0; u < upcomingCount; u++) {
+    UpcomingWakeup& timer = upcoming[u];
+    
+    switch (timer.state) {
       case WAKEUP_ARMED:
-        if (isTimeToStart(timers[i], now)) {
-          timers[i].state = WAKEUP_PREHEATING;
+        if (now >= timer.start) {
+          timer.state = WAKEUP_PREHEATING;
           #if DEBUG_ENABLED
             Serial.print(F("T"));
-            Serial.print(i);
+            Serial.print(timer.slot);
             Serial.println(F(" heat"));
           #endif
         }
         break;
-        
+      
       case WAKEUP_PREHEATING:
-        if (currentTemp >= timers[i].targetTemp - 1.0) {  // Within 1°C
-          timers[i].state = WAKEUP_READY;
+        if (currentTemp >= TEMP_C(timer.targetTemp) - WAKEUP_READY_MARGIN) {
+          timer.state = WAKEUP_READY;
           #if DEBUG_ENABLED
             Serial.print(F("T"));
-            Serial.print(i);
+            Serial.print(timer.slot);
             Serial.println(F(" ready"));
           #endif
-        } else if (isTimeToStop(timers[i], now)) {
-          timers[i].state = WAKEUP_EXPIRED;
+        } else if (now >= timer.stop) {
+          timer.state = WAKEUP_EXPIRED;
         }
         break;
-        
+      
       case WAKEUP_READY:
-        if (isTimeToStop(timers[i], now)) {
-          timers[i].state = WAKEUP_EXPIRED;
+        if (now >= timer.stop) {
+          timer.state = WAKEUP_EXPIRED;
           #if DEBUG_ENABLED
             Serial.print(F("T"));
-            Serial.print(i);
+            Serial.print(timer.slot);
             Serial.println(F(" exp"));
           #endif
         }
         break;
-        
-      case WAKEUP_EXPIRED:
-        // Will be reset by resetExpiredTimers
-        break;
-        
+      
       default:
         break;
     }
   }
 }
 
-void WakeupTimer::checkForNewActiveTimer(const DateTime& now) {
-  // Find highest priority active timer
-  int8_t newActiveIndex = -1;
+void WakeupTimer::checkForNewActiveTimer() {
+  // Find highest priority active timer (earliest start)
+  int8_t newActive = -1;
   
-  for (uint8_t i = 0; i < MAX_WAKEUP_TIMERS; i++) {
-    if (!timers[i].enabled) continue;
-    
-    if (timers[i].state == WAKEUP_PREHEATING || timers[i].state == WAKEUP_READY) {
-      if (newActiveIndex == -1 || timers[i].hour < timers[newActiveIndex].hour ||
-          (timers[i].hour == timers[newActiveIndex].hour && timers[i].minute < timers[newActiveIndex].minute)) {
-        newActiveIndex = i;
+  for (uint8_t u = 0; u < upcomingCount; u++) {
+    if (upcoming[u].state == WAKEUP_PREHEATING || upcoming[u].state == WAKEUP_READY) {
+      if (newActive == -1 || upcoming[u].start < upcoming[newActive].start) {
+        newActive = u;
       }
     }
   }
   
-  if (newActiveIndex != activeTimerIndex) {
-    activeTimerIndex = newActiveIndex;
-    if (activeTimerIndex >= 0) {
-      #if DEBUG_ENABLED
-        Serial.print(F("Act:"));
-        Serial.println(timers[activeTimerIndex].name);
-      #endif
+  const bool changed = (newActive >= 0) != (activeUpcoming >= 0) ||
+                       (newActive >= 0 && upcoming[newActive].slot != upcoming[activeUpcoming].slot);
+  activeUpcoming = newActive;
+  
+  #if DEBUG_ENABLED
+    if (changed && activeUpcoming >= 0) {
+      Serial.print(F("Act:T"));
+      Serial.println(upcoming[activeUpcoming].slot);
     }
+  #else
+    (void)changed;
+  #endif
+}
+
+bool WakeupTimer::removeExpiredTimers() {
+  uint8_t kept = 0;
+  for (uint8_t u = 0; u < upcomingCount; u++) {
+    if (upcoming[u].state != WAKEUP_EXPIRED) {
+      upcoming[kept++] = upcoming[u];
+    }
+  }
+  
+  const bool removed = (kept != upcomingCount);
+  upcomingCount = kept;
+  if (removed) {
+    activeUpcoming = -1;  // Positions moved; re-found by checkForNewActiveTimer
   }
+  return removed;
 }
 
-void WakeupTimer::resetExpiredTimers(const DateTime& now) {
-  for (uint8_t i = 0; i < MAX_WAKEUP_TIMERS; i++) {
-    if (timers[i].enabled && timers[i].state == WAKEUP_EXPIRED) {
-      // Reset for next occurrence
-      timers[i].state = WAKEUP_ARMED;
+int8_t WakeupTimer::findUpcoming(uint8_t slot) const {
+  for (uint8_t u = 0; u < upcomingCount; u++) {
+    if (upcoming[u].slot == slot) {
+      return u;
     }
   }
+  return -1;
 }
 
-bool WakeupTimer::isTimerDayActive(const WakeupTimerData& timer, const DateTime& now) const {
-  WakeupDay today = getCurrentDay(now);
-  return isDayEnabled(timer.dayMask, today);
+void WakeupTimer::scheduleNextAlarm() {
+  int8_t timerIndex;
+  const uint32_t next = findNextAlarmTime(timerIndex);
+  
+  if (timerIndex < 0) {
+    if (alarm1InUse) {
+      clearRTCAlarm(1);
+    }
+    return;
+  }
+  
+  if (alarm1InUse && next == alarm1Time) {
+    return;  // Already programmed
+  }
+  setRTCAlarm(1, DateTime(next), timerIndex);
+}
+
+void WakeupTimer::clearRTCAlarms() {
+  clearRTCAlarm(1);
+  clearRTCAlarm(2);
 }
 
-DateTime WakeupTimer::calculateStartTime(const WakeupTimerData& timer, const DateTime& now) const {
-  // Start heating WAKEUP_PREHEAT_MINUTES before target time
-  uint8_t startHour = timer.hour;
-  uint8_t startMinute = timer.minute;
+bool WakeupTimer::setRTCAlarm(uint8_t alarmNumber, const DateTime& alarmTime, int8_t timerIndex) {
+  // Alarm 2 has no seconds register and is left free; Alarm 1 covers the
+  // single next start, which is all the schedule needs
+  if (alarmNumber != 1 || !rtcManager->setAlarm1(alarmTime)) {
+    return false;
+  }
   
-  if (startMinute >= WAKEUP_PREHEAT_MINUTES) {
-    startMinute -= WAKEUP_PREHEAT_MINUTES;
-  } else {
-    startMinute = 60 - (WAKEUP_PREHEAT_MINUTES - startMinute);
-    if (startHour == 0) {
-      startHour = 23;
-    } else {
-      startHour--;
+  alarm1InUse = true;
+  alarm1TimerIndex = timerIndex;
+  alarm1Time = alarmTime.unixtime();
+  
+  #if DEBUG_ENABLED
+    char buf[6];
+    Format::clock(buf, alarmTime.hour(), alarmTime.minute());
+    Serial.print(F("A1 T"));
+    Serial.print(timerIndex);
+    Serial.print(F(" "));
+    Serial.println(buf);
+  #endif
+  return true;
+}
+
+void WakeupTimer::clearRTCAlarm(uint8_t alarmNumber) {
+  if (alarmNumber == 1) {
+    rtcManager->clearAlarm1();
+    alarm1InUse = false;
+    alarm1TimerIndex = -1;
+    alarm1Time = 0;
+  } else if (alarmNumber == 2) {
+    rtcManager->clearAlarm2();
+    alarm2InUse = false;
+    alarm2TimerIndex = -1;
+  }
+}
+
+uint32_t WakeupTimer::findNextAlarmTime(int8_t& timerIndex) const {
+  // Earliest start among armed occurrences (all in the future once
+  // updateTimerStates has run); reports the timer's slot
+  timerIndex = -1;
+  uint32_t earliest = NO_DEADLINE;
+  
+  for (uint8_t u = 0; u < upcomingCount; u++) {
+    if (upcoming[u].state == WAKEUP_ARMED && upcoming[u].start < earliest) {
+      earliest = upcoming[u].start;
+      timerIndex = upcoming[u].slot;
     }
   }
   
-  return DateTime(now.year(), now.month(), now.day(), startHour, startMinute, 0);
+  return earliest;
+}
+
+bool WakeupTimer::isAlarmAvailable() const {
+  return !alarm1InUse;
 }
 
 bool WakeupTimer::isValidTimerIndex(uint8_t index) const {
-  return index < MAX_WAKEUP_TIMERS;
+  return index < timerCount;
 }
 
 bool WakeupTimer::isValidTime(uint8_t hour, uint8_t minute) const {
@@ -407,15 +716,19 @@ void WakeupTimer::printStatus() const {
   #if DEBUG_ENABLED
     Serial.print(F("Timers: "));
     Serial.print(timerCount);
+    Serial.print(F(" Upcoming: "));
+    Serial.print(upcomingCount);
     Serial.print(F(" Active: "));
-    Serial.println(activeTimerIndex);
+    Serial.print(getActiveTimerIndex());
+    Serial.print(F(" A1: "));
+    Serial.println(alarm1TimerIndex);
   #endif
 }
 
 void WakeupTimer::printTimer(uint8_t index) const {
   #if DEBUG_ENABLED
-    if (!isValidTimerIndex(index)) return;
-    const WakeupTimerData& timer = timers[index];
+    StoredWakeupTimer timer;
+    if (!isValidTimerIndex(index) || !readRecord(sortedTimers[index].slot, timer)) return;
     Serial.print(F("T"));
     Serial.print(index);
     Serial.print(F(":"));
@@ -427,4 +740,4 @@ void WakeupTimer::printTimer(uint8_t index) const {
     Serial.print(timer.targetTemp);
     Serial.println(F("C"));
   #endif
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@
 
 #include "Config.h"
 #include "RTCManager.h"
+#include "AT24C32.h"
 
 // Structure for a single wake-up timer
 struct WakeupTimerData {
@@ -15,16 +16,46 @@ struct WakeupTimerData {
   char name[16];          // User-friendly name for the timer
 };
 
+// Timer record as stored in the AT24C32: one slot per page, and small
+// enough for one Wire transaction, so every save is a single page write
+struct StoredWakeupTimer {
+  uint8_t marker;         // WAKEUP_SLOT_USED, anything else is a free slot
+  uint8_t hour;
+  uint8_t minute;
+  uint8_t targetTemp;
+  uint8_t dayMask;
+  uint8_t enabled;
+  char name[16];
+  uint8_t reserved[7];
+  uint8_t crc;            // CRC8 over the bytes before it
+};
+
+// SRAM index entry, kept sorted by target time of day
+struct WakeupIndexEntry {
+  uint16_t minuteOfDay;   // hour * 60 + minute
+  uint8_t dayMask;        // WAKEUP_INDEX_ENABLED | day bits
+  uint8_t slot;           // Page within the EEPROM timer region
+};
+
+// One of the next few occurrences, the only timers held in full in SRAM
+struct UpcomingWakeup {
+  uint32_t start;         // Preheat start (unix seconds)
+  uint32_t stop;          // End of the heating window
+  uint8_t slot;
+  uint8_t targetTemp;
+  uint8_t state;          // WakeupState
+};
+
 class WakeupTimer {
   public:
-    WakeupTimer(RTCManager* rtcMgr);
+    WakeupTimer(RTCManager* rtcMgr, AT24C32* eepromPtr);
     
     // Core functionality
     bool begin();
-    void update(float currentTemp);
+    void update(temp_t currentTemp);
     void handleAlarmInterrupt(uint8_t alarmNumber);  // Called when RTC alarm triggers
     
-    // Timer management
+    // Timer management (index = position in time-of-day order)
     bool addTimer(uint8_t hour, uint8_t minute, uint8_t targetTemp, uint8_t dayMask, const char* name = "");
     bool removeTimer(uint8_t index);
     bool enableTimer(uint8_t index, bool enabled);
@@ -38,7 +69,7 @@ class WakeupTimer {
     
     // Status queries
     uint8_t getTimerCount() const { return timerCount; }
-    WakeupTimerData* getTimer(uint8_t index);
+    WakeupTimerData* getTimer(uint8_t index);  // Loaded from EEPROM; valid until the next call
     int8_t getActiveTimerIndex() const;
     WakeupState getActiveState() const;
     
@@ -51,8 +82,6 @@ class WakeupTimer {
     void clearRTCAlarms();     // Clear all RTC alarms
     
     // Time calculations
-    bool isTimeToStart(const WakeupTimerData& timer, const DateTime& now) const;
-    bool isTimeToStop(const WakeupTimerData& timer, const DateTime& now) const;
     unsigned long getMinutesUntilNextTimer() const;
     
     // Day of week utilities
@@ -63,31 +92,64 @@ class WakeupTimer {
     // Debug and status
     void printStatus() const;
     void printTimer(uint8_t index) const;
-    
+  
   private:
+    static const uint32_t NO_DEADLINE = 0xFFFFFFFFUL;
+    
     RTCManager* rtcManager;
-    WakeupTimerData timers[MAX_WAKEUP_TIMERS];
+    AT24C32* eeprom;
+    
+    // Every stored timer, sorted by time of day (no names, no state)
+    WakeupIndexEntry sortedTimers[MAX_WAKEUP_TIMERS];
     uint8_t timerCount;
-    int8_t activeTimerIndex;
+    
+    // The next WAKEUP_CACHE_SIZE occurrences in start order, rebuilt only
+    // when timers change or an occurrence ends
+    UpcomingWakeup upcoming[WAKEUP_CACHE_SIZE];
+    uint8_t upcomingCount;
+    uint32_t nextDeadline;     // Earliest start/stop still to act on
+    int8_t activeUpcoming;     // Position in upcoming[] of the heating timer
+    
+    WakeupTimerData viewTimer;  // Scratch record handed out by getTimer()
     unsigned long lastUpdateTime;
+    unsigned long lastAlarmPoll;
+    bool checkPending;         // Re-evaluate (and re-arm) on the next update()
     
     // RTC alarm tracking
     bool alarm1InUse;          // Is Alarm 1 being used for wake-up?
     bool alarm2InUse;          // Is Alarm 2 being used for wake-up?
-    int8_t alarm1TimerIndex;   // Which timer is using Alarm 1
-    int8_t alarm2TimerIndex;   // Which timer is using Alarm 2
+    int8_t alarm1TimerIndex;   // Which timer slot is using Alarm 1
+    int8_t alarm2TimerIndex;   // Which timer slot is using Alarm 2
+    uint32_t alarm1Time;       // Unix time programmed into Alarm 1 (0 once fired)
+    
+    // EEPROM table
+    bool loadTable();
+    bool readRecord(uint8_t slot, StoredWakeupTimer& record) const;
+    bool writeRecord(uint8_t slot, StoredWakeupTimer& record);
+    bool freeSlot(uint8_t slot);
+    int8_t findFreeSlot() const;
+    static uint16_t slotAddress(uint8_t slot);
+    
+    // Index maintenance
+    void insertIndexEntry(const WakeupIndexEntry& entry);
+    void removeIndexEntry(uint8_t index);
+    int8_t indexOfSlot(uint8_t slot) const;
+    bool updateRecord(uint8_t index, StoredWakeupTimer& record);
     
-    // Internal helper methods
-    void updateTimerStates(const DateTime& now, float currentTemp);
-    void checkForNewActiveTimer(const DateTime& now);
-    void resetExpiredTimers(const DateTime& now);
-    bool isTimerDayActive(const WakeupTimerData& timer, const DateTime& now) const;
-    DateTime calculateStartTime(const WakeupTimerData& timer, const DateTime& now) const;
+    // Schedule
+    bool nextOccurrence(const WakeupIndexEntry& entry, uint32_t now, uint32_t& start, uint32_t& stop) const;
+    void rebuildSchedule(uint32_t now);
+    void updateNextDeadline();
+    void updateTimerStates(uint32_t now, temp_t currentTemp);
+    void checkForNewActiveTimer();
+    bool removeExpiredTimers();
+    int8_t findUpcoming(uint8_t slot) const;
+    static WakeupDay epochDay(uint32_t epoch);
     
     // RTC alarm helper methods
     bool setRTCAlarm(uint8_t alarmNumber, const DateTime& alarmTime, int8_t timerIndex);
     void clearRTCAlarm(uint8_t alarmNumber);
-    DateTime findNextAlarmTime(int8_t& timerIndex) const;
+    uint32_t findNextAlarmTime(int8_t& timerIndex) const;
     bool isAlarmAvailable() const;
     
     // Validation helpers
@@ -96,4 +158,4 @@ class WakeupTimer {
     bool isValidTemp(uint8_t temp) const;
 };
 
-#endif // WAKEUPTIMER_H
\ No newline at end of file
+#endif // WAKEUPTIMER_H
@@ -0,0 +1,54 @@
+#include "WiperRamp.h"
+
+WiperRamp::WiperRamp(Adafruit_DS3502* ds3502Ptr)
+  : ds3502(ds3502Ptr), commanded(WIPER_LOW_SAFE), target(WIPER_LOW_SAFE), lastStepMs(0),
+    stepDelayMs(WIPER_STEP_DELAY_MS), stepSize(WIPER_STEP_SIZE) {
+}
+
+void WiperRamp::begin(uint8_t initialValue) {
+  target = initialValue;
+  write(initialValue);
+}
+
+void WiperRamp::write(uint8_t value) {
+  commanded = value;
+  ds3502->setWiper(value);
+  lastStepMs = millis();
+  
+  #if DEBUG_HEATER
+    DEBUG_PRINT("Wiper → ");
+    DEBUG_PRINTLN(value);
+  #endif
+}
+
+void WiperRamp::setTarget(uint8_t value) {
+  target = value;
+}
+
+void WiperRamp::jumpTo(uint8_t value) {
+  target = value;
+  if (commanded != value) {
+    write(value);
+  }
+}
+
+void WiperRamp::setSlewProfile(unsigned long stepDelay, uint8_t size) {
+  stepDelayMs = stepDelay;
+  stepSize = size ? size : 1;
+}
+
+void WiperRamp::tick() {
+  if (commanded == target) return;
+  
+  // Rate limiting for smooth transitions
+  if (millis() - lastStepMs < stepDelayMs) return;
+  
+  uint8_t next;
+  if (commanded < target) {
+    next = (target - commanded > stepSize) ? commanded + stepSize : target;
+  } else {
+    next = (commanded - target > stepSize) ? commanded - stepSize : target;
+  }
+  
+  write(next);
+}
@@ -0,0 +1,49 @@
+#ifndef WIPER_RAMP_H
+#define WIPER_RAMP_H
+
+#include <Arduino.h>
+#include <Adafruit_DS3502.h>
+#include "Config.h"
+
+// Non-blocking slew limiter for the DS3502 wiper. The controller sets a
+// target whenever it likes; tick() from the main loop walks the wiper
+// toward it at the configured rate and only touches I2C on a change.
+class WiperRamp {
+private:
+  // Hardware
+  Adafruit_DS3502* ds3502;
+  
+  // Ramp state
+  uint8_t commanded;   // Value last written to the DS3502
+  uint8_t target;      // Value the ramp is heading for
+  unsigned long lastStepMs;
+  
+  // Slew profile
+  unsigned long stepDelayMs;
+  uint8_t stepSize;
+  
+  void write(uint8_t value);
+
+public:
+  WiperRamp(Adafruit_DS3502* ds3502Ptr);
+  
+  // Initialization (writes the starting value immediately)
+  void begin(uint8_t initialValue);
+  
+  // Targets
+  void setTarget(uint8_t value);
+  void jumpTo(uint8_t value);  // Bypass the ramp (e.g. parking on OFF)
+  
+  // Main update method (call every loop)
+  void tick();
+  
+  // Slew profile: move stepSize counts every stepDelay ms
+  void setSlewProfile(unsigned long stepDelay, uint8_t size);
+  
+  // Status
+  uint8_t getCommanded() const { return commanded; }
+  uint8_t getTarget() const { return target; }
+  bool isSettled() const { return commanded == target; }
+};
+
+#endif // WIPER_RAMP_H